@@ -13,6 +13,7 @@ bool failsafeEverBeenReceived[MAX_CHANNELS_PER_RECEIVER];
 bool isRequestingBind = false;
 uint32_t lastRCPacketMillis = 0;
 bool hasNewRCData = false;
+uint16_t rcFramePeriod = 20000;
 
 gnss_telemetry_data_t GNSSTelemetryData;
 
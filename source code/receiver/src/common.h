@@ -15,6 +15,7 @@ extern bool failsafeEverBeenReceived[MAX_CHANNELS_PER_RECEIVER];
 extern bool isRequestingBind;
 extern uint32_t lastRCPacketMillis;
 extern bool hasNewRCData;
+extern uint16_t rcFramePeriod; //in microseconds, of the frame rate we are bound with
 
 #define TELEMETRY_NO_DATA  0x7FFF
 
@@ -44,6 +45,7 @@ typedef struct {
   uint8_t receiverID;     //set on bind
   uint8_t fhss_schema[NUM_HOP_CHANNELS]; // Index in freqList. This is the hopping sequence.
   bool    isMainReceiver;
+  uint8_t frameRate;      //set on bind. 0 = 50 Hz, 1 = 100 Hz, 2 = 150 Hz
   uint8_t outputChConfig[MAX_CHANNELS_PER_RECEIVER];
 } sys_params_t;
 
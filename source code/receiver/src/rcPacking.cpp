@@ -0,0 +1,160 @@
+#include "Arduino.h"
+
+#include "rcPacking.h"
+
+//--------------------------------------------------------------------------------------------------
+
+void writeBits(uint8_t *buff, uint16_t *bitPos, uint16_t val, uint8_t numBits)
+{
+  //spread over up to 3 bytes
+  uint8_t idx = *bitPos / 8;
+  uint8_t shift = *bitPos % 8;
+  uint32_t bits = ((uint32_t) val & ((1UL << numBits) - 1)) << (24 - numBits - shift);
+  buff[idx] |= (bits >> 16) & 0xFF;
+  if(shift + numBits > 8)
+    buff[idx + 1] |= (bits >> 8) & 0xFF;
+  if(shift + numBits > 16)
+    buff[idx + 2] |= bits & 0xFF;
+  *bitPos += numBits;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint16_t readBits(const uint8_t *buff, uint16_t *bitPos, uint8_t numBits)
+{
+  uint8_t idx = *bitPos / 8;
+  uint8_t shift = *bitPos % 8;
+  uint32_t bits = (uint32_t) buff[idx] << 16;
+  if(shift + numBits > 8)
+    bits |= (uint32_t) buff[idx + 1] << 8;
+  if(shift + numBits > 16)
+    bits |= buff[idx + 2];
+  *bitPos += numBits;
+  return (bits >> (24 - numBits - shift)) & ((1UL << numBits) - 1);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//A group of 4 channels is 40 bits, 5 whole bytes, so every channel of a group has a fixed
+//place in it and the shifts are constants. The last group is done in a zeroed copy.
+
+static inline void packGroup(uint8_t *buff, const uint16_t *values)
+{
+  buff[0] = values[0] >> 2;
+  buff[1] = (values[0] << 6) | ((values[1] >> 4) & 0x3F);
+  buff[2] = (values[1] << 4) | ((values[2] >> 6) & 0x0F);
+  buff[3] = (values[2] << 2) | ((values[3] >> 8) & 0x03);
+  buff[4] = values[3];
+}
+
+static inline void unpackGroup(const uint8_t *buff, uint16_t *values)
+{
+  values[0] = ((uint16_t) buff[0] << 2) | (buff[1] >> 6);
+  values[1] = ((uint16_t)(buff[1] & 0x3F) << 4) | (buff[2] >> 4);
+  values[2] = ((uint16_t)(buff[2] & 0x0F) << 6) | (buff[3] >> 2);
+  values[3] = ((uint16_t)(buff[3] & 0x03) << 8) | buff[4];
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void packFullRCChannels(uint8_t *buff, const uint16_t *values, uint8_t numChannels)
+{
+  while(numChannels >= 4)
+  {
+    packGroup(buff, values);
+    buff += 5;
+    values += 4;
+    numChannels -= 4;
+  }
+  if(numChannels > 0)
+  {
+    uint16_t last[4] = {0, 0, 0, 0};
+    uint8_t group[5];
+    for(uint8_t i = 0; i < numChannels; i++)
+      last[i] = values[i];
+    packGroup(group, last);
+    memcpy(buff, group, (numChannels * 10 + 7) / 8);
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void unpackFullRCChannels(const uint8_t *buff, uint16_t *values, uint8_t numChannels)
+{
+  while(numChannels >= 4)
+  {
+    unpackGroup(buff, values);
+    buff += 5;
+    values += 4;
+    numChannels -= 4;
+  }
+  if(numChannels > 0)
+  {
+    uint8_t group[5] = {0, 0, 0, 0, 0};
+    uint16_t last[4];
+    memcpy(group, buff, (numChannels * 10 + 7) / 8);
+    unpackGroup(group, last);
+    memcpy(values, last, numChannels * sizeof(values[0]));
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint8_t getRCChannelBits(uint8_t resolution, bool isMixed)
+{
+  return (isMixed ? 1 : 0) + (resolution == RC_CHANNEL_SWITCH ? 2 : 10);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void packRCChannel(uint8_t *buff, uint16_t *bitPos, uint16_t val, uint8_t resolution, bool isMixed)
+{
+  if(isMixed)
+    writeBits(buff, bitPos, resolution == RC_CHANNEL_SWITCH ? 1 : 0, 1);
+  if(resolution == RC_CHANNEL_SWITCH)
+  {
+    uint8_t position = (val + 250) / 500;
+    if(position > 2)
+      position = 2;
+    writeBits(buff, bitPos, position, 2);
+  }
+  else
+    writeBits(buff, bitPos, val, 10);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint8_t unpackRCChannels(const uint8_t *buff, uint8_t length, uint16_t *values, bool isMixed)
+{
+  uint16_t numBits = (uint16_t) length * 8;
+  uint8_t numChannels = 0;
+  if(!isMixed)
+  {
+    numChannels = numBits / 10;
+    if(numChannels > RC_MAX_CHANNELS)
+      numChannels = RC_MAX_CHANNELS;
+    unpackFullRCChannels(buff, values, numChannels);
+    return numChannels;
+  }
+
+  //The packing is padded with zeroes to a whole byte, which reads as the start of a full 
+  //resolution value that does not fit.
+  uint16_t bitPos = 0;
+  while(numChannels < RC_MAX_CHANNELS && bitPos < numBits)
+  {
+    uint16_t pos = bitPos;
+    uint8_t resolution = readBits(buff, &pos, 1);
+    if(bitPos + getRCChannelBits(resolution, true) > numBits)
+      break;
+    bitPos++;
+    if(resolution == RC_CHANNEL_SWITCH)
+    {
+      uint8_t position = readBits(buff, &bitPos, 2);
+      values[numChannels] = (position > 2 ? 2 : position) * 500;
+    }
+    else
+      values[numChannels] = readBits(buff, &bitPos, 10);
+    numChannels++;
+  }
+  return numChannels;
+}
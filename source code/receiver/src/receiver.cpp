@@ -27,6 +27,8 @@ int16_t outputPin[MAX_CHANNELS_PER_RECEIVER] = {
   PIN_CH10
 };
 
+#define FAILSAFE_TIMEOUT_FRAMES  50 //1 second at 50 Hz
+
 //--------------- Function Declarations ----------
 
 void writeOutputs();
@@ -110,7 +112,7 @@ void writeOutputs()
   static bool    failsafeActivated[MAX_CHANNELS_PER_RECEIVER];
   static bool    outputReinitialised[MAX_CHANNELS_PER_RECEIVER];
   
-  bool activateFailsafe = ((millis() - lastRCPacketMillis) > 1000);
+  bool activateFailsafe = ((millis() - lastRCPacketMillis) > (FAILSAFE_TIMEOUT_FRAMES * (uint32_t) rcFramePeriod) / 1000);
 
   if(!hasNewRCData && !activateFailsafe) //prevent unnecessary computation
     return;
@@ -8,6 +8,7 @@
 #include "crc.h"
 #include "eestore.h"
 #include "GNSS.h"
+#include "rcPacking.h"
 #include "rfComm.h"
 
 #define MAX_PAYLOAD_SIZE 26
@@ -57,6 +58,43 @@ uint8_t receivePacketLength;
   #error Number of hop channels cannot exceed number of available frequencies
 #endif 
 
+//--------------- Frame rates ------------------------
+/*
+  LoRa settings for each frame rate, chosen so that the RC packet fits in the frame.
+  All use 500 kHz bandwidth and coding rate 4/5. Air times as per the SX1276 datasheet.
+
+  Frame rate   SF   Header     Preamble   RC packet              Air time
+  50 Hz        7    explicit   8          up to 30 bytes (20ch)  16.7 ms
+  100 Hz       6    implicit   6          18 bytes (10ch)         6.2 ms
+  150 Hz       6    implicit   6          15 bytes (8ch)          5.5 ms
+
+  SF6 requires an implicit header, so at the higher frame rates every packet on the hop channels 
+  has a fixed length. Packets from the transmitter are padded to the length of the RC packet, 
+  those from the receiver to that of the GNSS telemetry packet (6.8 ms). 
+  Binding is always done with the 50 Hz settings. Keep in sync with the transmitter.
+
+  Telemetry is sent in the downlink slots of the transmitter's frame schedule. The RC packet 
+  just before a slot has the telemetry bit set, the slot starting when it ends.
+*/
+
+typedef struct {
+  uint16_t framePeriod;          //in microseconds
+  uint8_t  spreadingFactor;
+  uint8_t  preambleLength;
+  uint8_t  uplinkPacketLength;   //transmitter to receiver, 0 for explicit header
+  uint8_t  downlinkPacketLength; //receiver to transmitter, 0 for explicit header
+} frame_rate_profile_t;
+
+#define NUM_FRAME_RATES 3
+frame_rate_profile_t frameRateProfile[NUM_FRAME_RATES] = {
+  {20000, 7, 8, 0,  0 }, //50 Hz
+  {10000, 6, 6, 18, 21}, //100 Hz
+  {6667,  6, 6, 15, 21}  //150 Hz
+};
+
+uint8_t fixedTxPacketLength = 0; //0 if explicit header
+uint8_t fixedRxPacketLength = 0; //0 if explicit header
+
 //------------------------------------------------
 
 #if NUM_HOP_CHANNELS > (MAX_PAYLOAD_SIZE - 2)
@@ -73,6 +111,8 @@ enum {
   PACKET_RC_DATA = 5,
   PACKET_TELEMETRY_GENERAL = 6,
   PACKET_TELEMETRY_GNSS = 7,
+  PACKET_RC_KEYFRAME = 8,
+  PACKET_RC_DELTA = 9,
 
   PACKET_INVALID = 0xFF
 };
@@ -82,17 +122,32 @@ uint32_t rcPacketCount = 0;
 
 bool isSendingTelemetry = false;
 
+#if RC_MAX_CHANNELS > NUM_RC_CHANNELS
+  #error More channels in the RC packets than handled
+#endif
+
+//The channels of the last RC keyframe, which the delta packets apply to
+uint16_t keyframeChannels[NUM_RC_CHANNELS];
+uint8_t  keyframeNumChannels = 0; //0 if none yet
+uint8_t  keyframeNumber;
+
+#define KEYFRAME_TIMEOUT  300 //in ms, before the keyframe number can come round again
+
 int16_t telem_rssi;
 
-#define MAX_LISTEN_TIME_ON_HOP_CHANNEL 100 //in ms
+#define MAX_LISTEN_FRAMES_ON_HOP_CHANNEL 5 //100 ms at 50 Hz
+
+uint16_t maxListenTimeOnHopChannel = 100; //in ms
 
 //function declarations
 void setRfPower(uint8_t dBm);
+void setFrameRate(uint8_t idx);
 void bind();
 void hop();
 void sendTelemetry();
 void buildPacket(uint8_t sourceID, uint8_t destinationID, uint8_t dataIdentifier, uint8_t *dataBuffer, uint8_t dataLength);
 void readReceivedPacket();
+uint8_t decodeRCData(uint8_t packetType, uint16_t *chTemp);
 uint8_t checkReceivedPacket(uint8_t sourceID, uint8_t destinationID);
 
 //==================================================================================================
@@ -103,9 +158,9 @@ void initialiseRfModule()
   LoRa.setPins(PIN_LORA_SS, PIN_LORA_RESET); 
   if(LoRa.begin(freqList[0]))
   {
-    LoRa.setSpreadingFactor(7);
     LoRa.setCodingRate4(5);
     LoRa.setSignalBandwidth(500E3);
+    setFrameRate(0);
     delay(20);
     //start in low power level
     LoRa.sleep();
@@ -146,13 +201,13 @@ void doRfCommunication()
   uint8_t packetType = PACKET_INVALID;
   static uint32_t timeOfLastPacket = millis();
   
-  if(millis() - timeOfLastPacket > MAX_LISTEN_TIME_ON_HOP_CHANNEL)
+  if(millis() - timeOfLastPacket > maxListenTimeOnHopChannel)
   {
     timeOfLastPacket = millis();
     hop();
   }
 
-  if(LoRa.parsePacket()) //received a packet
+  if(LoRa.parsePacket(fixedRxPacketLength)) //received a packet
   {
     timeOfLastPacket = millis();
     telem_rssi = LoRa.packetRssi();
@@ -164,8 +219,14 @@ void doRfCommunication()
   switch(packetType)
   {
     case PACKET_RC_DATA:
+    case PACKET_RC_KEYFRAME:
+    case PACKET_RC_DELTA:
       {
-        uint8_t numReceivedChannels = ((receivePayloadLength - 1) * 8) / 10; // subtract 1 for flags byte
+        //Decode the RC data
+        uint16_t chTemp[NUM_RC_CHANNELS];
+        uint8_t numReceivedChannels = decodeRCData(packetType, chTemp);
+        if(numReceivedChannels == 0)
+          break;
 
         if(!Sys.isMainReceiver && numReceivedChannels <= MAX_CHANNELS_PER_RECEIVER)
         {
@@ -181,22 +242,8 @@ void doRfCommunication()
         digitalWrite(PIN_LED, HIGH);
 #endif
 
-        //Decode the RC data
-        uint16_t chTemp[NUM_RC_CHANNELS];
-        memset(chTemp, 0, sizeof(chTemp));
-        for(uint8_t chIdx = 0; chIdx < NUM_RC_CHANNELS && chIdx < numReceivedChannels; chIdx++)
-        {
-          uint8_t aIdx = chIdx + (chIdx / 4);
-          uint8_t bIdx = aIdx + 1;
-          uint8_t aShift = ((chIdx % 4) + 1) * 2;
-          uint8_t bShift = 8 - aShift;
-          uint16_t aMask = ((uint16_t)0x0400) - ((uint16_t)1 << aShift);
-          uint8_t  bMask = ((uint16_t)1 << (8 - bShift)) - 1;
-          chTemp[chIdx] = (((uint16_t)receivePayloadBuffer[aIdx] << aShift) & aMask) | (((uint16_t)receivePayloadBuffer[bIdx] >> bShift) & bMask);
-        }
-
         uint8_t flag = receivePayloadBuffer[receivePayloadLength - 1];
-        bool isFailsafeData = (flag >> 4) & 0x01;
+        bool isFailsafeData = (packetType == PACKET_RC_DATA) && ((flag >> 4) & 0x01);
 
         uint8_t startIdx = 0;
         uint8_t endIdx = MAX_CHANNELS_PER_RECEIVER - 1;
@@ -227,7 +274,7 @@ void doRfCommunication()
         static uint8_t power_dBm[3] = {3, 10, 17}; //2 mW, 10 mW, 50 mW
         setRfPower(power_dBm[flag & 0x07]);
         
-        //telemetry request
+        //a downlink slot follows
         bool isRequestingTelemetry = (flag >> 3) & 0x01;
         if(isRequestingTelemetry)
           sendTelemetry();
@@ -253,7 +300,7 @@ void doRfCommunication()
         transmitPayloadLength = idx;
         buildPacket(Sys.receiverID, Sys.transmitterID, PACKET_READ_OUTPUT_CH_CONFIG, transmitPayloadBuffer, transmitPayloadLength);
         delayMicroseconds(500);
-        if(LoRa.beginPacket())
+        if(LoRa.beginPacket(fixedTxPacketLength > 0))
         {
           LoRa.write(transmitPacketBuffer, transmitPacketLength);
           LoRa.endPacket(); //block until done transmitting
@@ -285,7 +332,7 @@ void doRfCommunication()
         memset(transmitPayloadBuffer, 0, sizeof(transmitPayloadBuffer));
         buildPacket(Sys.receiverID, Sys.transmitterID, PACKET_ACK_OUTPUT_CH_CONFIG, transmitPayloadBuffer, 0);
         delayMicroseconds(500);
-        if(LoRa.beginPacket())
+        if(LoRa.beginPacket(fixedTxPacketLength > 0))
         {
           LoRa.write(transmitPacketBuffer, transmitPacketLength);
           LoRa.endPacket(); //block until done transmitting
@@ -297,7 +344,7 @@ void doRfCommunication()
 
 #ifdef PIN_LED
   //--- TURN OFF LED TO INDICATE NO INCOMING RC DATA
-  if(millis() - lastRCPacketMillis > 100)
+  if(millis() - lastRCPacketMillis > maxListenTimeOnHopChannel)
     digitalWrite(PIN_LED, LOW);
 #endif
 
@@ -319,6 +366,21 @@ void setRfPower(uint8_t dBm)
 
 //--------------------------------------------------------------------------------------------------
 
+void setFrameRate(uint8_t idx)
+{
+  if(idx >= NUM_FRAME_RATES)
+    idx = 0;
+  LoRa.idle();
+  LoRa.setSpreadingFactor(frameRateProfile[idx].spreadingFactor);
+  LoRa.setPreambleLength(frameRateProfile[idx].preambleLength);
+  fixedTxPacketLength = frameRateProfile[idx].downlinkPacketLength;
+  fixedRxPacketLength = frameRateProfile[idx].uplinkPacketLength;
+  rcFramePeriod = frameRateProfile[idx].framePeriod;
+  maxListenTimeOnHopChannel = (MAX_LISTEN_FRAMES_ON_HOP_CHANNEL * (uint32_t) rcFramePeriod) / 1000;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 void hop()
 {
   static uint8_t idx_fhss_schema = 0; 
@@ -339,8 +401,9 @@ void hop()
 
 void bind()
 {
-  //--- Set to lowest power level
+  //--- Set to lowest power level and the bind settings
   setRfPower(2); // 2 dBm
+  setFrameRate(0);
   
   //--- Set to bind frequency
   LoRa.sleep();
@@ -354,7 +417,7 @@ void bind()
   uint32_t endTime = millis() + BIND_LISTEN_TIMEOUT;
   while(millis() < endTime)
   {
-    if(LoRa.parsePacket()) //received a packet
+    if(LoRa.parsePacket(fixedRxPacketLength)) //received a packet
     {
       readReceivedPacket();
       uint8_t txId = (receivePacketBuffer[0] >> 1) & 0x7F;;
@@ -372,6 +435,7 @@ void bind()
   
   if(!receivedBind) //hop and exit
   {
+    setFrameRate(Sys.frameRate);
     hop();  
     return;
   }
@@ -389,8 +453,9 @@ void bind()
     idx++;
   }
   
-  //check if we are binding as main or secondary
+  //check if we are binding as main or secondary, and the frame rate
   Sys.isMainReceiver = receivePayloadBuffer[idx] & 0x01;
+  Sys.frameRate = (receivePayloadBuffer[idx] >> 1) & 0x03;
   idx++;
   if(!Sys.isMainReceiver)
     Sys.receiverID = receivePayloadBuffer[idx];
@@ -408,7 +473,7 @@ void bind()
 
   buildPacket(0x00, Sys.transmitterID, PACKET_ACK_BIND, transmitPayloadBuffer, transmitPayloadLength);
   delayMicroseconds(500);
-  if(LoRa.beginPacket())
+  if(LoRa.beginPacket(fixedTxPacketLength > 0))
   {
     LoRa.write(transmitPacketBuffer, transmitPacketLength);
     LoRa.endPacket(); //block until done transmitting
@@ -417,6 +482,8 @@ void bind()
   
   //--- Save to EEPROM
   eeSaveSysConfig();
+  
+  setFrameRate(Sys.frameRate);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -439,7 +506,8 @@ void sendTelemetry() //TODO: implement custom telemetry, establish standard IDs
     //alternate between telemetry types
     static uint8_t counter = 0;
     counter++;
-    if(counter % 2 == 0 && hasGNSSModule && sizeof(GNSSTelemetryData) <= sizeof(transmitPayloadBuffer))
+    if(counter % 2 == 0 && hasGNSSModule && sizeof(GNSSTelemetryData) <= sizeof(transmitPayloadBuffer)
+       && (fixedTxPacketLength == 0 || 4 + sizeof(GNSSTelemetryData) <= fixedTxPacketLength))
       telemetryType = TELEMETRY_TYPE_GNSS;
     else
       telemetryType = TELEMETRY_TYPE_GENERAL;
@@ -502,7 +570,7 @@ void sendTelemetry() //TODO: implement custom telemetry, establish standard IDs
     }
 
     //start transmit
-    if(LoRa.beginPacket())
+    if(LoRa.beginPacket(fixedTxPacketLength > 0))
     {
       LoRa.write(transmitPacketBuffer, transmitPacketLength);
       LoRa.endPacket(true); //async
@@ -553,6 +621,64 @@ void buildPacket(uint8_t sourceID, uint8_t destinationID, uint8_t dataIdentifier
  
   //calculate the packet length
   transmitPacketLength = 4 + payloadLength;
+  
+  //pad to the fixed length if implicit header
+  if(transmitPacketLength < fixedTxPacketLength)
+    transmitPacketLength = fixedTxPacketLength;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//Decodes the channels of an RC packet into chTemp. Returns the number of channels, 0 if the 
+//packet cannot be used, as is a delta packet to a keyframe that was missed.
+uint8_t decodeRCData(uint8_t packetType, uint16_t *chTemp)
+{
+  if(receivePayloadLength == 0)
+    return 0;
+  uint8_t flag = receivePayloadBuffer[receivePayloadLength - 1];
+  memset(chTemp, 0, NUM_RC_CHANNELS * sizeof(chTemp[0]));
+
+  if(packetType == PACKET_RC_DELTA)
+  {
+    //a bit per channel that differs from the keyframe, their values, then the flags. After a 
+    //gap, as many keyframes as there are numbers may have been missed, so it is not used.
+    if(millis() - lastRCPacketMillis > KEYFRAME_TIMEOUT)
+      keyframeNumChannels = 0;
+    if(keyframeNumChannels == 0 || ((flag >> 4) & 0x07) != keyframeNumber)
+      return 0;
+    uint8_t maskLength = (keyframeNumChannels + 7) / 8;
+    uint8_t numChanged = 0;
+    for(uint8_t chIdx = 0; chIdx < keyframeNumChannels; chIdx++)
+    {
+      if((receivePayloadBuffer[chIdx / 8] >> (chIdx % 8)) & 0x01)
+        numChanged++;
+    }
+    if(maskLength + ((numChanged * 10) + 7) / 8 + 1 != receivePayloadLength)
+      return 0;
+    
+    memcpy(chTemp, keyframeChannels, sizeof(keyframeChannels));
+    uint16_t changed[RC_MAX_CHANNELS];
+    unpackFullRCChannels(receivePayloadBuffer + maskLength, changed, numChanged);
+    numChanged = 0;
+    for(uint8_t chIdx = 0; chIdx < keyframeNumChannels; chIdx++)
+    {
+      if((receivePayloadBuffer[chIdx / 8] >> (chIdx % 8)) & 0x01)
+        chTemp[chIdx] = changed[numChanged++];
+    }
+    return keyframeNumChannels;
+  }
+
+  bool isMixed = (flag >> 7) & 0x01;
+  uint8_t numChannels = unpackRCChannels(receivePayloadBuffer, receivePayloadLength - 1, chTemp, isMixed);
+
+  //the flags of a keyframe carry its number instead of the frame rate
+  if(packetType == PACKET_RC_KEYFRAME)
+  {
+    memcpy(keyframeChannels, chTemp, sizeof(keyframeChannels));
+    keyframeNumChannels = numChannels;
+    keyframeNumber = (flag >> 4) & 0x07;
+  }
+  return numChannels;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -25,6 +25,11 @@
 // #define DISPLAY_ST7920
 // #define DISPLAY_PCD8544 //not implemented
 
+//Maximum bytes sent to the LCD per frame, except on full screen messages. A frame that does not fit 
+//is sent over the next frames. Lower values cap the display time per frame, higher ones show changes 
+//sooner. The ST7920 sends whole row pairs of 32 bytes.
+#define LCD_FLUSH_BUDGET  256
+
 //===========================================================================
 //============================= Pins and ports ==============================
 //===========================================================================
@@ -106,6 +111,13 @@
 
 #define PIN_SD_CS    53
 
+//===========================================================================
+//============================= Link to the RF MCU ==========================
+//===========================================================================
+//Baud rate of the UART to stx, which must use the same. The AVR core sets the
+//double speed mode, in which 250000, 500000 and 1000000 are exact at 16 MHz.
+#define UART_BAUD_RATE   500000
+
 //===========================================================================
 //============================= External EEPROM =============================
 //===========================================================================
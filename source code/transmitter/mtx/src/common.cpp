@@ -171,6 +171,8 @@ bool     timerForceRun[NUM_TIMERS];
 uint8_t  maxNumOfModels;
 
 uint32_t thisLoopNum = 0; 
+uint32_t rcFrameCount = 0;
+uint8_t  rcFramesPerLoop = 1;
 
 uint32_t DBG_loopTime;
 
@@ -221,6 +223,7 @@ void resetSystemParams()
 
   Sys.rfEnabled = false;
   Sys.rfPower = RF_POWER_MEDIUM;
+  Sys.rfFrameRate = RF_FRAME_RATE_50HZ;
 
   Sys.soundEnabled = true;
   Sys.soundOnInactivity = true;
@@ -694,6 +697,7 @@ void resetChannelParams(uint8_t idx)
   Model.Channel[idx].failsafe  = -102;
   Model.Channel[idx].endpointL = -100;
   Model.Channel[idx].endpointR = 100;
+  Model.Channel[idx].resolution = CHANNEL_RESOLUTION_FULL;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1017,6 +1021,9 @@ bool verifySystemData()
   if(Sys.rfPower >= RF_POWER_COUNT) 
     isSane = false;
   
+  if(Sys.rfFrameRate >= RF_FRAME_RATE_COUNT) 
+    isSane = false;
+  
   if(Sys.defaultStickMode >= STICK_MODE_COUNT) 
     isSane = false;
   
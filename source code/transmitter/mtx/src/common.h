@@ -294,14 +294,18 @@ enum sensor_ID_e {
 //----------------- Main loop control ---------------------
 
 #define fixedLoopTime  20
-/* in milliseconds. Should be greater than the time taken by radio module to transmit the 
-entire packet or else the window is missed resulting in much less throughput. 
-It should also be close to the average worst case time to do the main loop i.e. when all features 
+/* in milliseconds. The period of the main loop, which runs the UI.
+It should be close to the average worst case time to do the main loop i.e. when all features 
 are active (mixers, logical switches, UI, etc).
 The main loop time can be displayed by enabling the option in the debug menu.
+The RC task runs rcFramesPerLoop times per main loop, as set by the frame rate. Each RC frame
+should be longer than the time taken by the radio module to transmit the packet, or else the 
+window is missed resulting in much less throughput.
 */
 
-extern uint32_t thisLoopNum; //main loop counter
+extern uint32_t thisLoopNum;     //main loop counter
+extern uint32_t rcFrameCount;    //RC frame counter, only for use within the RC task
+extern uint8_t  rcFramesPerLoop; //1 at 50 Hz, 2 at 100 Hz, 3 at 150 Hz
 
 //----------------- Debug ---------------------------------
 
@@ -383,6 +387,7 @@ typedef struct {
   //--- rf
   bool     rfEnabled;
   uint8_t  rfPower;   //3 levels. Low, Medium, Max
+  uint8_t  rfFrameRate;
 
   //--- sound
   bool     soundEnabled;
@@ -459,6 +464,14 @@ enum rf_power_level_e {
   RF_POWER_COUNT
 };
 
+enum rf_frame_rate_e {
+  RF_FRAME_RATE_50HZ,
+  RF_FRAME_RATE_100HZ,
+  RF_FRAME_RATE_150HZ,
+  
+  RF_FRAME_RATE_COUNT
+};
+
 enum trim_tone_freq_e {
   TRIM_TONE_FREQ_FIXED,
   TRIM_TONE_FREQ_VARIABLE,
@@ -530,8 +543,16 @@ typedef struct {
   int8_t   failsafe;      //-102 to 100. -102 means hold, -101 No pulse
   int8_t   endpointL;     //left endpoint, -100 to 0
   int8_t   endpointR;     //right endpoint, 0 to 100
+  uint8_t  resolution;    //over the air, see channel_resolution_e
 } channel_params_t;
 
+enum channel_resolution_e {
+  CHANNEL_RESOLUTION_FULL,
+  CHANNEL_RESOLUTION_SWITCH, //only the low, centre and high positions
+  
+  CHANNEL_RESOLUTION_COUNT
+};
+
 //------------------------------------------------
 // structure for custom telemetry parameters
 //------------------------------------------------
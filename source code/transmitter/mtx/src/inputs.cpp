@@ -3,8 +3,14 @@
 #include "../config.h"
 #include "common.h"
 #include "inputs.h"
+#include "mtx.h"
 
 int16_t deadzoneAndMap(int16_t input, int16_t minVal, int16_t centreVal, int16_t maxVal, int16_t deadzn, int16_t mapMin, int16_t mapMax);
+static void latchButtonCode();
+
+//The buttons as last read by the inputs owner. The background only sees them in buttonCode,
+//which is updated once per call to readSwitchesAndButtons().
+static volatile uint8_t buttonCodeRead = 0;
 
 const uint8_t swPin[NUM_PHYSICAL_SWITCHES][2] PROGMEM = {
   {PIN_SWA_UP, PIN_SWA_DN},
@@ -50,6 +56,12 @@ void initialiseSwitches()
 
 void readSwitchesAndButtons()
 {
+  if(!isInputsOwner())
+  {
+    latchButtonCode();
+    return;
+  }
+  
   //--Read switches--
   //These are read on every other call to the function, as an extra debounce measure,
   //at the expense of slight additional delay/lag.
@@ -79,22 +91,26 @@ void readSwitchesAndButtons()
   //--Read trims and UI buttons--
   //Only one button can be pressed at a time
   
-  buttonCode = 0;
-
-  if(!(PINx_TRIMS & 0x80)) buttonCode = KEY_X2_TRIM_UP;
-  if(!(PINx_TRIMS & 0x40)) buttonCode = KEY_X2_TRIM_DOWN;
-  if(!(PINx_TRIMS & 0x20)) buttonCode = KEY_Y2_TRIM_UP;
-  if(!(PINx_TRIMS & 0x10)) buttonCode = KEY_Y2_TRIM_DOWN;
-  if(!(PINx_TRIMS & 0x08)) buttonCode = KEY_Y1_TRIM_UP;
-  if(!(PINx_TRIMS & 0x04)) buttonCode = KEY_Y1_TRIM_DOWN;
-  if(!(PINx_TRIMS & 0x02)) buttonCode = KEY_X1_TRIM_UP;
-  if(!(PINx_TRIMS & 0x01)) buttonCode = KEY_X1_TRIM_DOWN;
-
-  if(!digitalRead(PIN_KEY_SELECT)) buttonCode = KEY_SELECT;
-  if(!digitalRead(PIN_KEY_UP))     buttonCode = KEY_UP;
-  if(!digitalRead(PIN_KEY_DOWN))   buttonCode = KEY_DOWN;
-
-  if(buttonCode != 0)
+  uint8_t code = 0;
+
+  if(!(PINx_TRIMS & 0x80)) code = KEY_X2_TRIM_UP;
+  if(!(PINx_TRIMS & 0x40)) code = KEY_X2_TRIM_DOWN;
+  if(!(PINx_TRIMS & 0x20)) code = KEY_Y2_TRIM_UP;
+  if(!(PINx_TRIMS & 0x10)) code = KEY_Y2_TRIM_DOWN;
+  if(!(PINx_TRIMS & 0x08)) code = KEY_Y1_TRIM_UP;
+  if(!(PINx_TRIMS & 0x04)) code = KEY_Y1_TRIM_DOWN;
+  if(!(PINx_TRIMS & 0x02)) code = KEY_X1_TRIM_UP;
+  if(!(PINx_TRIMS & 0x01)) code = KEY_X1_TRIM_DOWN;
+
+  if(!digitalRead(PIN_KEY_SELECT)) code = KEY_SELECT;
+  if(!digitalRead(PIN_KEY_UP))     code = KEY_UP;
+  if(!digitalRead(PIN_KEY_DOWN))   code = KEY_DOWN;
+
+  buttonCodeRead = code;
+  if(!isInRcTask()) //before the RC task is started
+    latchButtonCode();
+
+  if(code != 0)
     inputsLastMovedTime = millis();
   
   //-- play audio when switches are moved --
@@ -127,6 +143,17 @@ void readSwitchesAndButtons()
 
 //==================================================================================================
 
+static void latchButtonCode()
+{
+  //once, as the RC task may come in between
+  uint8_t oldSREG = SREG;
+  cli();
+  buttonCode = buttonCodeRead;
+  SREG = oldSREG;
+}
+
+//==================================================================================================
+
 static bool buttonActive = false;
 static uint8_t lastButtonCode = 0;
 static bool buttonEventsOverridden = false;
@@ -229,7 +256,7 @@ void killButtonEvents()
 
 void readSticks()
 {
-  if(isCalibratingControls)
+  if(isCalibratingControls || !isInputsOwner())
     return;
 
   //Read stick axes
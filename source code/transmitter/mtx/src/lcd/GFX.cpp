@@ -336,6 +336,14 @@ void GFX::drawChar(uint8_t x, uint8_t y, unsigned char c, uint8_t color)
   }
 }
 
+// Draw a run of characters, 6 pixels apart. Characters that would not be whole on the 
+// screen are skipped, like drawChar does.
+void GFX::drawText(uint8_t x, uint8_t y, const uint8_t *str, uint8_t len, uint8_t color)
+{
+  for(uint8_t i = 0; i < len && x < (_width - 5); i++, x += 6)
+    drawChar(x, y, str[i], color);
+}
+
 size_t GFX::write(uint8_t c)
 {
   if(c == '\n')
@@ -356,6 +364,48 @@ size_t GFX::write(uint8_t c)
   return 1;
 }
 
+// Runs of characters that fit on the line go to drawText() in one call. Anything else,
+// newlines and wrapping included, goes through write(c).
+size_t GFX::write(const uint8_t *buffer, size_t size)
+{
+  size_t n = 0;
+  while(n < size)
+  {
+    uint8_t len = 0;
+    while(n + len < size && len < 21 && buffer[n + len] != '\n' && buffer[n + len] != '\r')
+      len++;
+    if(len > 0 && cursor_x + 6 * len <= _width)
+    {
+      drawText(cursor_x, cursor_y, &buffer[n], len, textcolor);
+      cursor_x += 6 * len;
+      n += len;
+    }
+    else
+      write(buffer[n++]);
+  }
+  return size;
+}
+
+// The Print class writes PROGMEM strings a character at a time. Here they are copied to RAM 
+// in chunks, to be drawn as runs.
+size_t GFX::print(const __FlashStringHelper *str)
+{
+  const char *p = (const char *) str;
+  uint8_t buff[21];
+  size_t n = 0;
+  while(true)
+  {
+    uint8_t len = 0;
+    while(len < sizeof(buff) && (buff[len] = pgm_read_byte(p + len)) != 0)
+      len++;
+    n += write(buff, len);
+    if(len < sizeof(buff))
+      break;
+    p += len;
+  }
+  return n;
+}
+
 void GFX::setCursor(uint8_t x, uint8_t y)
 {
   cursor_x = x;
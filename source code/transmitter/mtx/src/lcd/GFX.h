@@ -56,7 +56,8 @@ public:
       drawHLine(uint8_t x, uint8_t y, uint8_t w, uint8_t color),
       fillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color),
       drawRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color),
-      drawChar(uint8_t x, uint8_t y, unsigned char c, uint8_t color);
+      drawChar(uint8_t x, uint8_t y, unsigned char c, uint8_t color),
+      drawText(uint8_t x, uint8_t y, const uint8_t *str, uint8_t len, uint8_t color);
 
   // These exist only with GFX (no subclass overrides)
   void
@@ -72,7 +73,12 @@ public:
       setTextColor(uint8_t c),
       setTextWrap(boolean w);
       
+  // Text. Runs of characters are drawn with drawText(), strings in PROGMEM included.
+  using Print::write;
+  using Print::print;
   virtual size_t write(uint8_t);
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  size_t print(const __FlashStringHelper *str);
 
   uint8_t height(void) const;
   uint8_t width(void) const;
@@ -11,6 +11,8 @@
 //asm volatile ("lpm \n" "lpm \n" "lpm \n" "nop \n") is 10 cycles (625 ns at 16 MHz)
 //If the display is glitchy, you may need to increase the delays below.
 
+#if defined(__AVR__)
+
 #define EN_DELAY_HIGHLOW { asm volatile ("lpm \n" "lpm \n" "lpm \n" "nop \n"); \
                            asm volatile ("lpm \n" "lpm \n" "lpm \n" "nop \n"); }
 
@@ -21,12 +23,36 @@
                            asm volatile ("lpm \n" "lpm \n" "lpm \n" "nop \n"); \
                            asm volatile ("lpm \n" "lpm \n" "lpm \n" "nop \n"); }
 
+#else //host build, no bus timing to respect
+
+#define EN_DELAY_HIGHLOW {}
+#define EN_DELAY_LOWHIGH {}
+
+#endif
+
 #define START_LINE    0b11000000
 #define SET_Y_ADDRESS 0b01000000
 #define SET_PAGE      0b10111000
 #define DISP_ON       0b00111111
 #define DISP_OFF      0b00111110
 
+#define CHUNK_SIZE    16 //columns of a page summed together
+
+//--------------------------------------------------------------------------------------------------
+
+//Fletcher style sum of a chunk. Any one byte changed changes it. The rare change that keeps it is
+//fixed by the page resent every now and then.
+static uint16_t chunkSum(const uint8_t *buff)
+{
+  uint8_t a = 0, b = 0;
+  for(uint8_t i = 0; i < CHUNK_SIZE; i++)
+  {
+    a += buff[i];
+    b += a;
+  }
+  return ((uint16_t) b << 8) | a;
+}
+
 //--------------------------------------------------------------------------------------------------
 
 LCDKS0108::LCDKS0108(int8_t rs, int8_t en, int8_t cs1, int8_t cs2) : GFX(LCDWIDTH, LCDHEIGHT)
@@ -39,11 +65,23 @@ LCDKS0108::LCDKS0108(int8_t rs, int8_t en, int8_t cs1, int8_t cs2) : GFX(LCDWIDT
 
 //--------------------------------------------------------------------------------------------------
 
+//Marks the chunks of a page holding columns x0 to x1 as drawn
+inline void LCDKS0108::markInk(uint8_t page, uint8_t x0, uint8_t x1)
+{
+  if(staticPages & (1 << page)) //drawn over
+    dropStaticPages(1 << page);
+  drawnPages |= 1 << page;
+  inkChunks[page] |= (0xFF << (x0 / CHUNK_SIZE)) & (0xFF >> (7 - x1 / CHUNK_SIZE));
+}
+
+//--------------------------------------------------------------------------------------------------
+
 // the most basic function, set a single pixel
 void LCDKS0108::drawPixel(uint8_t x, uint8_t y, uint8_t color)
 {
   if(x >= LCDWIDTH || y >= LCDHEIGHT) 
     return;
+  markInk(y / 8, x, x);
   uint16_t idx = (uint16_t) LCDWIDTH * (y / 8) + x;
   if(color)
     dispBuffer[idx] |= (1 << (y % 8));
@@ -68,7 +106,7 @@ uint8_t LCDKS0108::getPixel(uint8_t x, uint8_t y)
 //Credit: cbm80amiga's ST7567 library https://github.com/cbm80amiga/ST7567_FB
 void LCDKS0108::drawVLine(uint8_t x, uint8_t y, uint8_t h, uint8_t color)
 {
-  if(x >= LCDWIDTH) 
+  if(x >= LCDWIDTH || h == 0) 
     return;
   
   if(y >= LCDHEIGHT) 
@@ -99,6 +137,9 @@ void LCDKS0108::drawVLine(uint8_t x, uint8_t y, uint8_t h, uint8_t color)
   const uint8_t ystab[8] = {0xff, 0xfe, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0, 0x80};
   const uint8_t yetab[8] = {0x01, 0x03, 0x07, 0x0f, 0x1f, 0x3f, 0x7f, 0xff};
   
+  for(uint8_t page = y8s; page <= y8e; page++)
+    markInk(page, x, x);
+  
   if(color)
   {
     if(y8s==y8e) 
@@ -132,7 +173,7 @@ void LCDKS0108::drawVLine(uint8_t x, uint8_t y, uint8_t h, uint8_t color)
 //Credit: cbm80amiga's ST7567 library https://github.com/cbm80amiga/ST7567_FB
 void LCDKS0108::drawHLine(uint8_t x, uint8_t y, uint8_t w, uint8_t color)
 {
-  if(y >= LCDHEIGHT) 
+  if(y >= LCDHEIGHT || w == 0) 
     return;
   
   if(x >= LCDWIDTH) 
@@ -155,6 +196,8 @@ void LCDKS0108::drawHLine(uint8_t x, uint8_t y, uint8_t w, uint8_t color)
   if(x1 >= LCDWIDTH)
     x1 = LCDWIDTH - 1;
   
+  markInk(y / 8, x0, x1);
+  
   uint8_t mask = 1 << (y&7);
   if(color)
   {
@@ -176,44 +219,83 @@ void LCDKS0108::drawChar(uint8_t x, uint8_t y, unsigned char c, uint8_t color)
 {
   if(x >= (LCDWIDTH - 5) || y >= LCDHEIGHT) 
     return;
-  
-  uint8_t y0 = y;
-  uint8_t y1 = y0 + 7;
-  if(y1 >= LCDHEIGHT)
-    y1 = LCDHEIGHT - 1;
-  
-  //determine the start and end page in the display buffer (0 to 7). The display buffer is divided
-  //into 8 pages, just like the LCD's RAM, with each page containing 128 bytes (columns)
-  uint8_t y8s = y0/8; //start page
-  uint8_t y8e = y1/8; //end page
+  blitText(x, y, &c, 1, color);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+// Draws a run of characters with the checks done once for the run
+void LCDKS0108::drawText(uint8_t x, uint8_t y, const uint8_t *str, uint8_t len, uint8_t color)
+{
+  if(y >= LCDHEIGHT || len == 0) 
+    return;
+  //characters that would not be whole on the screen are skipped, like drawChar does
+  if(x + 6 * len > LCDWIDTH)
+  {
+    if(x >= LCDWIDTH - 5)
+      return;
+    len = (LCDWIDTH - 5 - 1 - x) / 6 + 1;
+  }
+  blitText(x, y, str, len, color);
+}
 
-  //determine how much to bit shift.
-  uint8_t sShift = y0 % 8;
+//--------------------------------------------------------------------------------------------------
+
+// Draws len characters from x, all of them whole on the screen.
+// The glyph columns go straight into the page, and into the next one when y is not page aligned.
+// Characters are 6 pixels apart, the sixth column is left as it is.
+void LCDKS0108::blitText(uint8_t x, uint8_t y, const uint8_t *str, uint8_t len, uint8_t color)
+{
+  uint8_t y8s = y / 8;  //start page
+  uint8_t sShift = y % 8;
   uint8_t eShift = 8 - sShift;
-  
-  //read a 'line' (vertical) from the character and draw it.
-  uint16_t s = y8s * LCDWIDTH;
-  uint16_t e = y8e * LCDWIDTH; 
-  uint16_t cc = (uint16_t) 5 * c; 
-  uint8_t line;
-  if(color)
+  uint8_t xEnd = x + 6 * len - 2;
+
+  uint8_t *s = &dispBuffer[(uint16_t) LCDWIDTH * y8s + x];
+  markInk(y8s, x, xEnd);
+
+  if(sShift == 0)
   {
-    for(uint8_t i = 0; i < 5; i++, x++)
-    { 
-      line = pgm_read_byte(&font[cc+i]);
-      dispBuffer[s+x] |= (line << sShift);
-      if(y8s != y8e)           
-        dispBuffer[e+x] |= (line >> eShift); 
+    //page aligned, the common case in menus. Whole glyph columns
+    for(uint8_t k = 0; k < len; k++, s += 6)
+    {
+      const unsigned char *glyph = &font[(uint16_t) 5 * str[k]];
+      if(color)
+      {
+        for(uint8_t i = 0; i < 5; i++)
+          s[i] |= pgm_read_byte(&glyph[i]);
+      }
+      else
+      {
+        for(uint8_t i = 0; i < 5; i++)
+          s[i] &= ~pgm_read_byte(&glyph[i]);
+      }
     }
+    return;
   }
-  else
+
+  //two pages at once. On the last page, the lower part of the glyph is off the screen.
+  bool hasEndPage = (y8s < 7);
+  if(hasEndPage)
+    markInk(y8s + 1, x, xEnd);
+  for(uint8_t k = 0; k < len; k++, s += 6)
   {
-    for(uint8_t i = 0; i < 5; i++, x++)
-    { 
-      line = pgm_read_byte(&font[cc+i]);
-      dispBuffer[s+x] &= ~(line << sShift); 
-      if(y8s != y8e) 
-        dispBuffer[e+x] &= ~(line >> eShift); 
+    const unsigned char *glyph = &font[(uint16_t) 5 * str[k]];
+    for(uint8_t i = 0; i < 5; i++)
+    {
+      uint8_t line = pgm_read_byte(&glyph[i]);
+      if(color)
+      {
+        s[i] |= (line << sShift);
+        if(hasEndPage)
+          s[i + LCDWIDTH] |= (line >> eShift);
+      }
+      else
+      {
+        s[i] &= ~(line << sShift);
+        if(hasEndPage)
+          s[i + LCDWIDTH] &= ~(line >> eShift);
+      }
     }
   }
 }
@@ -262,6 +344,16 @@ void LCDKS0108::writePageColumn(uint8_t page, uint8_t column, uint8_t val)
   EN_DELAY_HIGHLOW;      //Delay 
   *enPort &= ~enPinMask; //EN low 
   EN_DELAY_LOWHIGH;      //Delay
+  
+  //the sum no longer tells what the LCD shows, the next frame taken resends the chunk
+  unknownChunks[page] |= 1 << (column / CHUNK_SIZE);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint16_t LCDKS0108::getBytesFlushed()
+{
+  return bytesFlushed;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -295,6 +387,21 @@ void LCDKS0108::begin()
   
   //interlacing
   isInterlacedScan = false;
+  
+  //the LCD RAM holds garbage at power on, so the first flush sends everything
+  memset(dispBuffer, 0, sizeof(dispBuffer));
+  memset(lcdSums, 0, sizeof(lcdSums));
+  memset(inkChunks, 0, sizeof(inkChunks));
+  memset(dirtyChunks, 0, sizeof(dirtyChunks));
+  memset(pendingChunks, 0, sizeof(pendingChunks));
+  memset(unknownChunks, 0xFF, sizeof(unknownChunks));
+  staticPages = 0;
+  keptPages = 0;
+  drawnPages = 0;
+  isFramePending = false;
+  frameCount = 0;
+  flushBudget = 0xFFFF;
+  bytesFlushed = 0;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -317,9 +424,99 @@ void LCDKS0108::setInterlace(bool enabled)
 
 //--------------------------------------------------------------------------------------------------
 
+void LCDKS0108::setFlushBudget(uint16_t maxBytes)
+{
+  flushBudget = maxBytes > 0 ? maxBytes : 1;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//The pages in the mask become a static layer, kept for the current frame. clearDynamicLayer() 
+//leaves them as drawn, so what is on them only needs to be drawn once. They have to be kept again
+//in each frame before anything else is drawn on them, otherwise they are stale and get cleared.
+void LCDKS0108::setStaticLayer(uint8_t pages)
+{
+  dropStaticPages(staticPages & ~pages);
+  staticPages = pages;
+  keptPages = pages;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//Keeps more pages for the current frame. The other static pages stay, to be kept or go stale.
+void LCDKS0108::addStaticLayer(uint8_t pages)
+{
+  staticPages |= pages;
+  keptPages |= pages;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//Takes pages out of the static layer. A page kept for this frame is still shown in it, and gets
+//cleared by the next clear. A stale page is cleared right away.
+void LCDKS0108::dropStaticPages(uint8_t pages)
+{
+  staticPages &= ~pages;
+  for(uint8_t page = 0; page < 8; page++)
+  {
+    if(!(pages & (1 << page)))
+      continue;
+    if(keptPages & (1 << page))
+      inkChunks[page] = 0xFF;
+    else
+    {
+      memset(&dispBuffer[(uint16_t) LCDWIDTH * page], 0, LCDWIDTH);
+      dirtyChunks[page] = 0xFF;
+    }
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint8_t LCDKS0108::getStaticLayer()
+{
+  return staticPages;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint8_t LCDKS0108::getDrawnPages()
+{
+  return drawnPages;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 void LCDKS0108::clearDisplay() //Clear frame buffer
 {
-  memset(dispBuffer, 0, sizeof(dispBuffer));
+  setStaticLayer(0);
+  clearDynamicLayer();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void LCDKS0108::clearDynamicLayer()
+{
+  //Only the drawn chunks can be non zero. Clearing them may change what is to be shown, 
+  //so they become dirty until the next frame is taken. The static pages are left as drawn.
+  for(uint8_t page = 0; page < 8; page++)
+  {
+    uint8_t chunks = inkChunks[page];
+    if(chunks == 0)
+      continue;
+    if(!(staticPages & (1 << page)))
+    {
+      for(uint8_t n = 0; n < 8; n++)
+      {
+        if(chunks & (1 << n))
+          memset(&dispBuffer[(uint16_t) LCDWIDTH * page + n * CHUNK_SIZE], 0, CHUNK_SIZE);
+      }
+    }
+    dirtyChunks[page] |= chunks;
+    inkChunks[page] = 0;
+  }
+  keptPages = 0;
+  drawnPages = 0;
   cursor_y = cursor_x = 0; //These are in GFX lib
 }
 
@@ -327,139 +524,134 @@ void LCDKS0108::clearDisplay() //Clear frame buffer
 
 void LCDKS0108::display()
 {
-  //Progressive scan
-  uint8_t startPage = 0, endPage = 7, step = 1;
-  uint16_t dataIdx = 0;
+  //Progressive scan sends the whole frame before returning.
   
   //Interlaced scan
   /*
-  With interlacing, we alternate between sending the odd and even pages.
-  There are a total of 8 pages (0 to 7), but for interlace we only send half of these,
-  thus we in essence halve the time taken compared to full frame (progressive scan). 
-  The catch however is that the half frames are not exactly halves of the same image, 
-  and they can be significantly different when there is fast motion, or when the scene changes. 
-  However as long as the display() function is being called at a fast enough rate 
-  say greater than 50x a second, interlacing artifacts (especially combing) 
-  wont be noticeable to the eye.
+  Sending a changing screen in full takes a few milliseconds, which can be too long for a single
+  frame. So with interlacing, at most flushBudget bytes are sent per call, in whole chunks, and 
+  a frame that does not fit is sent over the next calls. The next frame is only taken once the 
+  one being sent is complete. Without a copy of it, the chunks left are sent as the frame buffer 
+  has them then, so the LCD may show parts of the next frame a call or two early. As long as 
+  the display() function is being called at a fast enough rate say greater than 50x a second, 
+  the gradual update wont be noticeable to the eye.
   */
-  if(isInterlacedScan)
+  uint16_t maxBytes = isInterlacedScan ? flushBudget : 0xFFFF;
+  
+  dropStaticPages(staticPages & ~keptPages); //stale
+  
+  bytesFlushed = 0;
+  if(isFramePending)
   {
-    static bool even;
-    even = !even;
-    if(even){startPage = 0; endPage = 6; step = 2; dataIdx = 0;}
-    else    {startPage = 1; endPage = 7; step = 2; dataIdx = 128;}
+    sendPending(maxBytes);
+    if(isFramePending)
+      return;
   }
+  takeFrame();
+  sendPending(maxBytes);
+}
 
-  //Output to the physical display
-  for(uint8_t page = startPage; page <= endPage; page += step)
-  {
-    setPage(page);
-    
-    //rs high
-    *rsPort |= rsPinMask; 
+//--------------------------------------------------------------------------------------------------
 
-    //enable chip1, disable chip2
-    #if defined (CS_ACTIVE_LOW)
-    *cs1Port &= ~cs1PinMask;  
-    *cs2Port |= cs2PinMask;
-    #else
-    *cs1Port |= cs1PinMask;  
-    *cs2Port &= ~cs2PinMask; 
-    #endif
-    
-    /*     
-    for(uint8_t column = 0; column < 128; column++)
+//Notes the chunks of the frame buffer whose sum differs from what the LCD shows, to be sent
+void LCDKS0108::takeFrame()
+{
+  //Resend a page in full every now and then, in case the LCD missed a write or got corrupted. 
+  //All the pages get refreshed in about 5 seconds at 50 frames per second.
+  frameCount++;
+  if((frameCount & 0x1F) == 0)
+    unknownChunks[(frameCount >> 5) & 0x07] = 0xFF;
+
+  //Only the chunks that were drawn or cleared can differ from what was sent
+  for(uint8_t page = 0; page < 8; page++)
+  {
+    uint8_t pending = unknownChunks[page];
+    uint8_t chunks = (inkChunks[page] | dirtyChunks[page]) & ~pending;
+    for(uint8_t n = 0; chunks != 0; n++, chunks >>= 1)
     {
-      if(column == 64)
-      {
-        //enable chip2, disable chip1
-      #if defined (CS_ACTIVE_LOW)
-        *cs2Port &= ~cs2PinMask;
-        *cs1Port |= cs1PinMask;
-      #else 
-        *cs2Port |= cs2PinMask; 
-        *cs1Port &= ~cs1PinMask;
-      #endif
-      }
-      
-      PORTx_LCD_DATA = dispBuffer[dataIdx++]; //write
-      *enPort |= enPinMask;  //EN high
-      EN_DELAY_HIGHLOW;      //Delay 
-      *enPort &= ~enPinMask; //EN low 
-      EN_DELAY_LOWHIGH;      //Delay
+      if((chunks & 1) && chunkSum(&dispBuffer[(uint16_t) LCDWIDTH * page + n * CHUNK_SIZE]) != lcdSums[page * 8 + n])
+        pending |= 1 << n;
     }
-    */
+    pendingChunks[page] = pending;
+    dirtyChunks[page] = 0;
+    unknownChunks[page] = 0;
+  }
+  
+  isFramePending = true;
+}
+
+//--------------------------------------------------------------------------------------------------
 
-    
-    //Unrolled loop version
-    //this saves about 0.6 ms in progressive scan mode
-    //at the expense of a few bytes more flash memory usage
-    for(uint8_t column = 0; column < 128; column += 8)
+//Sends the pending chunks to the LCD, until maxBytes have been sent in this flush
+void LCDKS0108::sendPending(uint16_t maxBytes)
+{
+  for(uint8_t page = 0; page < 8; page++)
+  {
+    bool isAddressSet = false;
+    for(uint8_t n = 0; n < 8; n++)
     {
-      if(column == 64)
+      if(!(pendingChunks[page] & (1 << n)))
       {
-        //enable chip2, disable chip1
-      #if defined (CS_ACTIVE_LOW)
-        *cs2Port &= ~cs2PinMask;
-        *cs1Port |= cs1PinMask;
-      #else 
-        *cs2Port |= cs2PinMask; 
-        *cs1Port &= ~cs1PinMask;
-      #endif
+        isAddressSet = false;
+        continue;
       }
       
-      PORTx_LCD_DATA = dispBuffer[dataIdx++]; //write
-      *enPort |= enPinMask;  //EN high
-      EN_DELAY_HIGHLOW;      //Delay 
-      *enPort &= ~enPinMask; //EN low 
-      EN_DELAY_LOWHIGH;      //Delay
-      
-      PORTx_LCD_DATA = dispBuffer[dataIdx++]; //write
-      *enPort |= enPinMask;  //EN high
-      EN_DELAY_HIGHLOW;      //Delay 
-      *enPort &= ~enPinMask; //EN low 
-      EN_DELAY_LOWHIGH;      //Delay
-      
-      PORTx_LCD_DATA = dispBuffer[dataIdx++]; //write
-      *enPort |= enPinMask;  //EN high
-      EN_DELAY_HIGHLOW;      //Delay 
-      *enPort &= ~enPinMask; //EN low 
-      EN_DELAY_LOWHIGH;      //Delay
+      //at least a chunk per call
+      if(bytesFlushed > 0 && bytesFlushed + CHUNK_SIZE > maxBytes)
+        return;
       
-      PORTx_LCD_DATA = dispBuffer[dataIdx++]; //write
-      *enPort |= enPinMask;  //EN high
-      EN_DELAY_HIGHLOW;      //Delay 
-      *enPort &= ~enPinMask; //EN low 
-      EN_DELAY_LOWHIGH;      //Delay
-      
-      PORTx_LCD_DATA = dispBuffer[dataIdx++]; //write
-      *enPort |= enPinMask;  //EN high
-      EN_DELAY_HIGHLOW;      //Delay 
-      *enPort &= ~enPinMask; //EN low 
-      EN_DELAY_LOWHIGH;      //Delay
-      
-      PORTx_LCD_DATA = dispBuffer[dataIdx++]; //write
-      *enPort |= enPinMask;  //EN high
-      EN_DELAY_HIGHLOW;      //Delay 
-      *enPort &= ~enPinMask; //EN low 
-      EN_DELAY_LOWHIGH;      //Delay
-      
-      PORTx_LCD_DATA = dispBuffer[dataIdx++]; //write
-      *enPort |= enPinMask;  //EN high
-      EN_DELAY_HIGHLOW;      //Delay 
-      *enPort &= ~enPinMask; //EN low 
-      EN_DELAY_LOWHIGH;      //Delay
+      if(!isAddressSet || n == 4)
+      {
+        lcdCommand(SET_PAGE | page);
+        lcdCommand(SET_Y_ADDRESS | ((n * CHUNK_SIZE) & 0x3F));
+        
+        //rs high
+        *rsPort |= rsPinMask; 
+        
+        if(n < 4)
+        {
+          //enable chip1, disable chip2
+        #if defined (CS_ACTIVE_LOW)
+          *cs1Port &= ~cs1PinMask;  
+          *cs2Port |= cs2PinMask;
+        #else
+          *cs1Port |= cs1PinMask;  
+          *cs2Port &= ~cs2PinMask; 
+        #endif
+        }
+        else
+        {
+          //enable chip2, disable chip1
+        #if defined (CS_ACTIVE_LOW)
+          *cs2Port &= ~cs2PinMask;
+          *cs1Port |= cs1PinMask;
+        #else 
+          *cs2Port |= cs2PinMask; 
+          *cs1Port &= ~cs1PinMask;
+        #endif
+        }
+        isAddressSet = true;
+      }
       
-      PORTx_LCD_DATA = dispBuffer[dataIdx++]; //write
-      *enPort |= enPinMask;  //EN high
-      EN_DELAY_HIGHLOW;      //Delay 
-      *enPort &= ~enPinMask; //EN low 
-      EN_DELAY_LOWHIGH;      //Delay
+      //The write loop used to be unrolled for full pages, which saved about 0.6 ms per frame.
+      //With only the changed chunks being sent, it no longer pays for the flash it takes.
+      const uint8_t *buff = &dispBuffer[(uint16_t) LCDWIDTH * page + n * CHUNK_SIZE];
+      for(uint8_t i = 0; i < CHUNK_SIZE; i++)
+      {
+        PORTx_LCD_DATA = buff[i]; //write
+        *enPort |= enPinMask;  //EN high
+        EN_DELAY_HIGHLOW;      //Delay 
+        *enPort &= ~enPinMask; //EN low 
+        EN_DELAY_LOWHIGH;      //Delay
+      }
+      //sum what was sent, the buffer may have changed since the frame was taken
+      lcdSums[page * 8 + n] = chunkSum(buff);
+      bytesFlushed += CHUNK_SIZE;
+      pendingChunks[page] &= ~(1 << n);
     }
-
-    if(isInterlacedScan)
-      dataIdx += 128;
   }
+  
+  isFramePending = false;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -18,9 +18,15 @@ class LCDKS0108 : public GFX
 
     void begin();
     void clearDisplay();
+    void clearDynamicLayer(); //clears all but the static layer
     void display();
     
     void setInterlace(bool enabled);
+    void setFlushBudget(uint16_t maxBytes); //bytes sent per display() call when interlaced
+    void setStaticLayer(uint8_t pages); //keeps the pages for this frame, bit n for rows 8n to 8n+7
+    void addStaticLayer(uint8_t pages); //same, leaving the other static pages as they are
+    uint8_t getStaticLayer();
+    uint8_t getDrawnPages(); //pages drawn on since the last clear
 
     void drawPixel(uint8_t x, uint8_t y, uint8_t color);
     uint8_t getPixel(uint8_t x, uint8_t y);
@@ -28,9 +34,12 @@ class LCDKS0108 : public GFX
     void drawHLine(uint8_t x, uint8_t y, uint8_t w, uint8_t color);
     void drawVLine(uint8_t x, uint8_t y, uint8_t h, uint8_t color);
     void drawChar(uint8_t x, uint8_t y, unsigned char c, uint8_t color);
+    void drawText(uint8_t x, uint8_t y, const uint8_t *str, uint8_t len, uint8_t color);
     
     void writePageColumn(uint8_t page, uint8_t column, uint8_t val); //direct access
 
+    uint16_t getBytesFlushed(); //data bytes sent to the LCD by the last display()
+
   private:
     int8_t _rs, _en, _cs1, _cs2;
     
@@ -39,11 +48,36 @@ class LCDKS0108 : public GFX
     // The memory buffer for holding the data to be sent to the LCD
     uint8_t dispBuffer[LCDWIDTH * LCDHEIGHT / 8];
 
+    // A sum of what the LCD shows per chunk of 16 columns of a page (index page*8 + column/16),
+    // in place of a copy of the LCD RAM. display() only sends the chunks whose sum changed.
+    uint16_t lcdSums[64];
+
+    // Chunks per page, bit n for columns 16n to 16n+15. 'ink' is what has been drawn since the 
+    // last clearDisplay(), 'dirty' what has been cleared since the last frame was taken. Outside
+    // of both, the frame buffer matches the LCD. 'pending' is what is still to be sent, 'unknown'
+    // what the LCD may not show as summed, sent whatever the sum.
+    uint8_t inkChunks[8], dirtyChunks[8], pendingChunks[8], unknownChunks[8];
+
+    // Pages left as drawn by clearDynamicLayer(), and those of them kept for the current frame. 
+    // A static page that is not kept is stale, and cleared before it is drawn on or sent.
+    uint8_t staticPages, keptPages;
+    uint8_t drawnPages;
+
+    bool isFramePending;
+    uint8_t frameCount;
+    uint16_t flushBudget;
+    uint16_t bytesFlushed;
+
     volatile PortReg *rsPort, *enPort, *cs1Port, *cs2Port;
     PortMask rsPinMask, enPinMask, cs1PinMask, cs2PinMask;
 
     void lcdCommand(uint8_t command);
     void setPage(uint8_t page);
+    void markInk(uint8_t page, uint8_t x0, uint8_t x1);
+    void dropStaticPages(uint8_t pages);
+    void blitText(uint8_t x, uint8_t y, const uint8_t *str, uint8_t len, uint8_t color);
+    void takeFrame();
+    void sendPending(uint16_t maxBytes);
 };
 
 #endif
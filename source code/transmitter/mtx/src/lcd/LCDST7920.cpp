@@ -16,6 +16,8 @@ Thus the minimum delays we need at the microcontroller side are (2/(470k)) and (
 which rounds to about 70 and 140 cycles respectively. ( 1 cycle is 62.5 ns at 16 MHz)
 */
 
+#if defined(__AVR__)
+
 #define EN_DELAY_HIGHLOW { asm volatile ("lpm \n" "lpm \n" "lpm \n" "nop \n"); \
                            asm volatile ("lpm \n" "lpm \n" "lpm \n" "nop \n"); \
                            asm volatile ("lpm \n" "lpm \n" "lpm \n" "nop \n"); \
@@ -39,6 +41,30 @@ which rounds to about 70 and 140 cycles respectively. ( 1 cycle is 62.5 ns at 16
                            asm volatile ("lpm \n" "lpm \n" "lpm \n" "nop \n"); \
                            asm volatile ("lpm \n" "lpm \n" "lpm \n" "nop \n"); }
 
+#else //host build, no bus timing to respect
+
+#define EN_DELAY_HIGHLOW {}
+#define EN_DELAY_LOWHIGH {}
+
+#endif
+
+//--------------------------------------------------------------------------------------------------
+
+//Fletcher style sum of half a row of the frame buffer, 'half' being the row * 2 plus 1 for the 
+//right side. Any one byte changed changes it. The rare change that keeps it is fixed by the rows 
+//resent every now and then.
+static uint16_t halfRowSum(const uint8_t *dispBuffer, uint8_t half)
+{
+  const uint8_t *buff = &dispBuffer[(uint16_t) half * 8];
+  uint8_t a = 0, b = 0;
+  for(uint8_t i = 0; i < 8; i++)
+  {
+    a += buff[i];
+    b += a;
+  }
+  return ((uint16_t) b << 8) | a;
+}
+
 //--------------------------------------------------------------------------------------------------
 
 LCDST7920::LCDST7920(int8_t rs, int8_t en) : GFX(LCDWIDTH, LCDHEIGHT)
@@ -49,12 +75,32 @@ LCDST7920::LCDST7920(int8_t rs, int8_t en) : GFX(LCDWIDTH, LCDHEIGHT)
 
 //--------------------------------------------------------------------------------------------------
 
+//Marks rows y0 to y1 as drawn. Rows y and y+32 share a GDRAM row pair, and so a bit.
+inline void LCDST7920::markInk(uint8_t y0, uint8_t y1)
+{
+  uint8_t pages = (0xFF << (y0 / 8)) & (0xFF >> (7 - y1 / 8));
+  if(staticPages & pages) //drawn over
+    dropStaticPages(staticPages & pages);
+  drawnPages |= pages;
+  
+  if(y1 - y0 >= 31)
+    inkRows = 0xFFFFFFFF;
+  else
+  {
+    for(uint8_t y = y0; y <= y1; y++)
+      inkRows |= (uint32_t) 1 << (y & 31);
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+
 // the most basic function, set a single pixel
 void LCDST7920::drawPixel(uint8_t x, uint8_t y, uint8_t color)
 {
   if(x >= LCDWIDTH || y >= LCDHEIGHT) 
     return;
 
+  markInk(y, y);
   uint16_t idx = ((uint16_t) LCDWIDTH * y + x) / 8;
   if(color)
     dispBuffer[idx] |= (0x80 >> (x & 7));
@@ -81,7 +127,7 @@ uint8_t LCDST7920::getPixel(uint8_t x, uint8_t y)
 //Credit: cbm80amiga's ST7920 library
 void LCDST7920::drawVLine(uint8_t x, uint8_t y, uint8_t h, uint8_t color)
 {
-  if(x >= LCDWIDTH) 
+  if(x >= LCDWIDTH || h == 0) 
     return;
   
   if(y >= LCDHEIGHT) 
@@ -104,6 +150,8 @@ void LCDST7920::drawVLine(uint8_t x, uint8_t y, uint8_t h, uint8_t color)
   if(y1 >= LCDHEIGHT)
     y1 = LCDHEIGHT - 1;
   
+  markInk(y0, y1);
+  
   uint8_t mask = 0x80 >> (x & 7);
   
   if(color)
@@ -124,7 +172,7 @@ void LCDST7920::drawVLine(uint8_t x, uint8_t y, uint8_t h, uint8_t color)
 //Credit: cbm80amiga's ST7920 library
 void LCDST7920::drawHLine(uint8_t x, uint8_t y, uint8_t w, uint8_t color)
 {
-  if(y >= LCDHEIGHT)
+  if(y >= LCDHEIGHT || w == 0)
     return;
 
   if(x >= LCDWIDTH)
@@ -147,6 +195,8 @@ void LCDST7920::drawHLine(uint8_t x, uint8_t y, uint8_t w, uint8_t color)
   if(x1 >= LCDWIDTH)
     x1 = LCDWIDTH - 1;
 
+  markInk(y, y);
+  
   uint16_t yadd = (y * LCDWIDTH) / 8;
 
   uint8_t x8s = x0 / 8;
@@ -190,60 +240,61 @@ void LCDST7920::drawChar(uint8_t x, uint8_t y, unsigned char c, uint8_t color)
 {
   if(x >= (LCDWIDTH - 5) || y >= LCDHEIGHT) 
     return;
-  
+  blitText(x, y, &c, 1, color);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+// Draws a run of characters with the checks done once for the run
+void LCDST7920::drawText(uint8_t x, uint8_t y, const uint8_t *str, uint8_t len, uint8_t color)
+{
+  if(y >= LCDHEIGHT || len == 0) 
+    return;
+  //characters that would not be whole on the screen are skipped, like drawChar does
+  if(x + 6 * len > LCDWIDTH)
+  {
+    if(x >= LCDWIDTH - 5)
+      return;
+    len = (LCDWIDTH - 5 - 1 - x) / 6 + 1;
+  }
+  blitText(x, y, str, len, color);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+// Draws len characters from x, all of them whole on the screen.
+// The run is drawn a row at a time, each glyph row going into the one or two bytes it spans.
+// Characters are 6 pixels apart, the gap is left as it is.
+void LCDST7920::blitText(uint8_t x, uint8_t y, const uint8_t *str, uint8_t len, uint8_t color)
+{
   uint8_t jCount = 8;
   if(y >= LCDHEIGHT - 7)
     jCount = LCDHEIGHT - y;
-
-  //Determine the start and end horizontal 'page'
-  uint8_t x8s = x / 8;        //start
-  uint8_t x8e = (x + 5) / 8;  //end
-  
-  //Determine how much to bit shift.
-  uint8_t sShift = x % 8;
-  uint8_t eShift = 8 - sShift;
   
-  //Get the starting index of the character (in the font table)
-  uint16_t cc = (uint16_t) 8 * c; 
+  markInk(y, y + jCount - 1);
 
-  //Write to the display buffer
-  if(color)
-  {
-    if(x8s == x8e)
-    {
-      for(uint8_t j = 0; j < jCount; j++)
-      {
-        uint8_t line = pgm_read_byte(&font_hh[cc + j]);
-        dispBuffer[((uint16_t)(y + j) * LCDWIDTH / 8) + x8s] |= (line >> sShift);
-      }
-    }
-    else
-    {
-      for(uint8_t j = 0; j < jCount; j++)
-      {
-        uint8_t line = pgm_read_byte(&font_hh[cc + j]);
-        dispBuffer[((uint16_t)(y + j) * LCDWIDTH / 8) + x8s] |= (line >> sShift);
-        dispBuffer[((uint16_t)(y + j) * LCDWIDTH / 8) + x8e] |= (line << eShift);
-      }
-    }
-  }
-  else
+  for(uint8_t j = 0; j < jCount; j++)
   {
-    if(x8s == x8e)
+    uint8_t *row = &dispBuffer[(uint16_t)(y + j) * LCDWIDTH / 8];
+    uint8_t pos = x;
+    for(uint8_t k = 0; k < len; k++, pos += 6)
     {
-      for(uint8_t j = 0; j < jCount; j++)
+      uint8_t line = pgm_read_byte(&font_hh[(uint16_t) 8 * str[k] + j]);
+      
+      //Determine the start and end horizontal 'page', and how much to bit shift
+      uint8_t x8s = pos / 8;
+      uint8_t sShift = pos % 8;
+      if(color)
       {
-        uint8_t line = pgm_read_byte(&font_hh[cc + j]);
-        dispBuffer[((uint16_t)(y + j) * LCDWIDTH / 8) + x8s] &= ~(line >> sShift);
+        row[x8s] |= (line >> sShift);
+        if(sShift > 2)
+          row[x8s + 1] |= (line << (8 - sShift));
       }
-    }
-    else
-    {
-      for(uint8_t j = 0; j < jCount; j++)
+      else
       {
-        uint8_t line = pgm_read_byte(&font_hh[cc + j]);
-        dispBuffer[((uint16_t)(y + j) * LCDWIDTH / 8) + x8s] &= ~(line >> sShift);
-        dispBuffer[((uint16_t)(y + j) * LCDWIDTH / 8) + x8e] &= ~(line << eShift);
+        row[x8s] &= ~(line >> sShift);
+        if(sShift > 2)
+          row[x8s + 1] &= ~(line << (8 - sShift));
       }
     }
   }
@@ -362,6 +413,20 @@ void LCDST7920::begin()
   
   //interlacing
   isInterlacedScan = false;
+  
+  //the GDRAM holds garbage at power on, so the first flush sends everything
+  memset(dispBuffer, 0, sizeof(dispBuffer));
+  memset(halfRowSums, 0, sizeof(halfRowSums));
+  inkRows = 0;
+  dirtyRows = 0;
+  unknownRows = 0xFFFFFFFF;
+  staticPages = 0;
+  keptPages = 0;
+  drawnPages = 0;
+  pendingRows = 0;
+  frameCount = 0;
+  flushBudget = 0xFFFF;
+  bytesFlushed = 0;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -376,9 +441,96 @@ void LCDST7920::setInterlace(bool enabled)
 
 //--------------------------------------------------------------------------------------------------
 
+void LCDST7920::setFlushBudget(uint16_t maxBytes)
+{
+  flushBudget = maxBytes;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//The pages in the mask become a static layer, kept for the current frame. clearDynamicLayer() 
+//leaves their rows as drawn, so what is on them only needs to be drawn once. They have to be kept
+//again in each frame before anything else is drawn on them, otherwise they are stale and get cleared.
+void LCDST7920::setStaticLayer(uint8_t pages)
+{
+  dropStaticPages(staticPages & ~pages);
+  staticPages = pages;
+  keptPages = pages;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//Keeps more pages for the current frame. The other static pages stay, to be kept or go stale.
+void LCDST7920::addStaticLayer(uint8_t pages)
+{
+  staticPages |= pages;
+  keptPages |= pages;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//Takes pages out of the static layer. A page kept for this frame is still shown in it, and gets
+//cleared by the next clear. A stale page is cleared right away.
+void LCDST7920::dropStaticPages(uint8_t pages)
+{
+  staticPages &= ~pages;
+  for(uint8_t page = 0; page < 8; page++)
+  {
+    if(!(pages & (1 << page)))
+      continue;
+    uint32_t rows = (uint32_t) 0xFF << ((page * 8) & 31);
+    if(keptPages & (1 << page))
+      inkRows |= rows;
+    else
+    {
+      memset(&dispBuffer[(uint16_t) page * 8 * 16], 0, 8 * 16);
+      dirtyRows |= rows;
+    }
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint8_t LCDST7920::getStaticLayer()
+{
+  return staticPages;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint8_t LCDST7920::getDrawnPages()
+{
+  return drawnPages;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 void LCDST7920::clearDisplay() //Clear frame buffer
 {
-  memset(dispBuffer, 0, sizeof(dispBuffer));
+  setStaticLayer(0);
+  clearDynamicLayer();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void LCDST7920::clearDynamicLayer()
+{
+  //Only the drawn row pairs can be non zero. Clearing them may change what is to be shown, 
+  //so they become dirty until the next frame is taken. The rows of the static pages are left 
+  //as drawn.
+  for(uint8_t j = 0; j < 32; j++)
+  {
+    if(!(inkRows & ((uint32_t) 1 << j)))
+      continue;
+    if(!(staticPages & (1 << (j / 8))))
+      memset(&dispBuffer[(uint16_t) j * 16], 0, 16);
+    if(!(staticPages & (1 << ((j + 32) / 8))))
+      memset(&dispBuffer[(uint16_t) (j + 32) * 16], 0, 16);
+  }
+  dirtyRows |= inkRows;
+  inkRows = 0;
+  keptPages = 0;
+  drawnPages = 0;
   cursor_y = cursor_x = 0; //These are in GFX lib
 }
 
@@ -386,81 +538,137 @@ void LCDST7920::clearDisplay() //Clear frame buffer
 
 void LCDST7920::display()
 {
-  uint16_t dataIdx = 0;
-
-  // progressive scan
-  uint8_t jStart = 0, jEnd = 31, jStep = 1;
+  // progressive scan sends the whole frame before returning
   
   // interlaced scan
-  /*   
-  if(isInterlacedScan)
-  {
-    static bool even;
-    even = !even;
-    if(even) {jStart = 0; jEnd = 30; jStep = 2;}
-    else     {jStart = 1; jEnd = 31; jStep = 2;}
-  } 
+  /*
+  This LCD is relatively slow, a whole frame takes several milliseconds. 
+  So with interlacing, at most flushBudget bytes are sent per call, in whole row spans, and a 
+  frame that does not fit is sent over the next calls. The next frame is only taken from the frame 
+  buffer once the one being sent is complete. Without a copy of it, the spans left are sent as the 
+  frame buffer has them then, so the LCD may show parts of the next frame a call or two early.
   */
-  if(isInterlacedScan)
+  uint16_t maxBytes = isInterlacedScan ? flushBudget : 0xFFFF;
+
+  dropStaticPages(staticPages & ~keptPages); //stale
+  
+  bytesFlushed = 0;
+  if(pendingRows != 0)
   {
-    // Here we use an extreme form of interlacing since this LCD is relatively slow.
-    // We divide the screen into four portions, and we update only one portion at every call of the display function. 
-
-    // Method 1
-    /*
-    static uint8_t qq = 0;
-    jStart = 0 + (qq % 4);
-    jEnd = 28 + (qq % 4);
-    jStep = 4;
-    qq++;
-    */
+    sendPending(maxBytes);
+    if(pendingRows != 0)
+      return;
+  }
+  takeFrame();
+  sendPending(maxBytes);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//Notes the row spans of the frame buffer whose sums differ from what the LCD shows, to be sent.
+/*
+The GDRAM is addressed by row pair, vertical address j (0 to 31) holding row j in its horizontal 
+words 0 to 7 and row j+32 in words 8 to 15. The horizontal address auto increments, but the 
+vertical one does not, so each row pair sent costs an address set. Here each row pair gets a span
+from the first to the last of its four half rows whose sum changed, and row pairs with no change 
+are skipped altogether.
+*/
+void LCDST7920::takeFrame()
+{
+  //Resend an eighth of the screen in full every now and then, in case the LCD missed a write or 
+  //got corrupted. All of it gets refreshed in about 5 seconds at 50 frames per second.
+  frameCount++;
+  if((frameCount & 0x1F) == 0)
+    unknownRows |= (uint32_t) 0x0F << (4 * ((frameCount >> 5) & 0x07));
+
+  uint32_t rows = inkRows | dirtyRows | unknownRows;
+  for(uint8_t j = 0; j < 32; j++)
+  {
+    if(!(rows & ((uint32_t) 1 << j)))
+      continue;
     
-    // Method 2
-    // This produces less noticeable visual artifacts (combing, etc.)
-    static uint8_t qq = 0;
-    jStart = 8 * (qq % 4);
-    jEnd = jStart + 7;
-    jStep = 1;
-    qq++;
+    //byte b of the row pair, b < 16 in row j, otherwise in row j+32. Half row q = b / 8.
+    uint8_t first = 0, last = 31;
+    if(!(unknownRows & ((uint32_t) 1 << j)))
+    {
+      uint8_t changed = 0;
+      for(uint8_t q = 0; q < 4; q++)
+      {
+        uint8_t half = (q < 2 ? j * 2 : (j + 32) * 2) + (q & 1);
+        if(halfRowSum(dispBuffer, half) != halfRowSums[half])
+          changed |= 1 << q;
+      }
+      if(changed == 0)
+        continue;
+      while(!(changed & (1 << (first / 8))))
+        first += 8;
+      while(!(changed & (1 << (last / 8))))
+        last -= 8;
+    }
+    pendFirst[j] = first;
+    pendLast[j] = last;
+    pendingRows |= (uint32_t) 1 << j;
   }
+  
+  dirtyRows = 0;
+  unknownRows = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
 
-  for(uint8_t j = jStart; j <= jEnd; j += jStep)
+//Sends the pending row spans to the LCD, until maxBytes have been sent in this flush.
+//A span is always sent whole, so at least one goes out per call.
+void LCDST7920::sendPending(uint16_t maxBytes)
+{
+  for(uint8_t j = 0; j < 32; j++)
   {
+    if(!(pendingRows & ((uint32_t) 1 << j)))
+      continue;
+    uint8_t first = pendFirst[j];
+    uint8_t last = pendLast[j];
+    if(bytesFlushed > 0 && bytesFlushed + (last - first + 1) > maxBytes)
+      return;
+    
     //set GDRAM address. Vertical address first, followed by horizontal address
     delayMicroseconds(100); //tried 80 and less, they do not work, display becomes glitchy.
     lcdCommand(0b10000000 | j);
     // delayMicroseconds(100); //not necessary
-    lcdCommand(0b10000000 | 0);
+    lcdCommand(0b10000000 | (first / 2));
     delayMicroseconds(100);
 
-    dataIdx = (uint16_t) j * 16;
-
-    for(uint8_t i = 0; i < 16; i++)
+    //burst the data, rs stays high throughout
+    *rsPort |= rsPinMask; //rs high
+    uint16_t upper = (uint16_t) j * 16;
+    uint16_t lower = (uint16_t) (j + 32) * 16 - 16;
+    for(uint8_t b = first; b <= last; b++)
     {
-      *rsPort |= rsPinMask; //rs high
-      PORTx_LCD_DATA = dispBuffer[dataIdx++];
+      PORTx_LCD_DATA = dispBuffer[(b < 16 ? upper : lower) + b];
       *enPort |= enPinMask;  //EN high
       EN_DELAY_HIGHLOW;      //Delay 
       *enPort &= ~enPinMask; //EN low 
       EN_DELAY_LOWHIGH;      //Delay
     } 
     
-    dataIdx = (uint16_t) (j + 32) * 16;
-    
-    for(uint8_t i = 0; i < 16; i++)
+    //sum what was sent, the buffer may have changed since the frame was taken
+    for(uint8_t q = first / 8; q <= last / 8; q++)
     {
-      *rsPort |= rsPinMask; //rs high
-      PORTx_LCD_DATA = dispBuffer[dataIdx++];
-      *enPort |= enPinMask;  //EN high
-      EN_DELAY_HIGHLOW;      //Delay 
-      *enPort &= ~enPinMask; //EN low 
-      EN_DELAY_LOWHIGH;      //Delay
-    } 
+      uint8_t half = (q < 2 ? j * 2 : (j + 32) * 2) + (q & 1);
+      halfRowSums[half] = halfRowSum(dispBuffer, half);
+    }
+    bytesFlushed += last - first + 1;
+    pendingRows &= ~((uint32_t) 1 << j);
   }
 }
 
 //--------------------------------------------------------------------------------------------------
 
+uint16_t LCDST7920::getBytesFlushed()
+{
+  return bytesFlushed;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 inline void LCDST7920::lcdCommand(uint8_t command)
 {
   *rsPort &= ~rsPinMask; //rs low
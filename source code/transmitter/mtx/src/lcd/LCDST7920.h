@@ -18,9 +18,15 @@ class LCDST7920 : public GFX
 
     void begin();
     void clearDisplay();
+    void clearDynamicLayer(); //clears all but the static layer
     void display();
     
     void setInterlace(bool enabled);
+    void setFlushBudget(uint16_t maxBytes); //bytes sent per display() call when interlaced
+    void setStaticLayer(uint8_t pages); //keeps the pages for this frame, bit n for rows 8n to 8n+7
+    void addStaticLayer(uint8_t pages); //same, leaving the other static pages as they are
+    uint8_t getStaticLayer();
+    uint8_t getDrawnPages(); //pages drawn on since the last clear
 
     void drawPixel(uint8_t x, uint8_t y, uint8_t color);
     uint8_t getPixel(uint8_t x, uint8_t y);
@@ -28,6 +34,9 @@ class LCDST7920 : public GFX
     void drawHLine(uint8_t x, uint8_t y, uint8_t w, uint8_t color);
     void drawVLine(uint8_t x, uint8_t y, uint8_t h, uint8_t color);
     void drawChar(uint8_t x, uint8_t y, unsigned char c, uint8_t color);
+    void drawText(uint8_t x, uint8_t y, const uint8_t *str, uint8_t len, uint8_t color);
+
+    uint16_t getBytesFlushed(); //data bytes sent to the LCD by the last display()
 
   private:
     int8_t _rs, _en;
@@ -37,10 +46,36 @@ class LCDST7920 : public GFX
     // The memory buffer for holding the data to be sent to the LCD
     uint8_t dispBuffer[LCDWIDTH * LCDHEIGHT / 8];
 
+    // A sum of what the LCD shows per half row, in place of a copy of the GDRAM. 
+    // display() only sends the half rows of a new frame whose sum changed.
+    uint16_t halfRowSums[LCDHEIGHT * 2];
+
+    // One bit per GDRAM row pair (rows j and j+32). 'ink' is what has been drawn since the last 
+    // clearDisplay(), 'dirty' what has been cleared since the last frame was taken. Outside of 
+    // both, the frame buffer matches what was sent. 'unknown' is sent whatever the sums. 
+    // 'pending' is what is still to be sent, bytes pendFirst to pendLast of the row pair.
+    uint32_t inkRows, dirtyRows, unknownRows;
+    uint32_t pendingRows;
+    uint8_t pendFirst[32], pendLast[32];
+
+    // Pages of 8 rows left as drawn by clearDynamicLayer(), and those of them kept for the current 
+    // frame. A static page that is not kept is stale, and cleared before it is drawn on or sent.
+    uint8_t staticPages, keptPages;
+    uint8_t drawnPages;
+
+    uint8_t frameCount;
+    uint16_t flushBudget;
+    uint16_t bytesFlushed;
+
     volatile PortReg *rsPort, *enPort;
     PortMask rsPinMask, enPinMask;
 
     void lcdCommand(uint8_t command);
+    void markInk(uint8_t y0, uint8_t y1);
+    void dropStaticPages(uint8_t pages);
+    void blitText(uint8_t x, uint8_t y, const uint8_t *str, uint8_t len, uint8_t color);
+    void takeFrame();
+    void sendPending(uint16_t maxBytes);
 };
 
 #endif
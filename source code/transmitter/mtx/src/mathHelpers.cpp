@@ -2,8 +2,6 @@
 
 #include "mathHelpers.h"
 
-int32_t calcTangent(int16_t xValues[], int16_t yValues[], uint8_t numValues, uint8_t i);
-
 //--------------------------------------------------------------------------------------------------
 
 int32_t divRoundClosest(int32_t n, int32_t d)
@@ -8,6 +8,7 @@ int32_t applySlow(int32_t currVal, int32_t targetVal, int32_t range, int32_t mul
 int16_t generateWaveform(uint8_t idx, int32_t _currTime);
 void evaluateLogicalSwitches(uint32_t _currTime);
 void evaluateCounters();
+int16_t evaluateCurve(uint8_t crvIdx, int16_t xVal);
 
 //mix sources array
 int16_t mixSources[MIX_SOURCES_COUNT]; 
@@ -28,6 +29,9 @@ uint32_t dlyStartTime[NUM_MIX_SLOTS];
 int32_t  slowCurrVal[NUM_MIX_SLOTS];
 uint8_t  hldOldState[NUM_MIX_SLOTS];
 
+//frame in which the RC task first saw the current heldButton event, for the trim key repeat
+static uint32_t heldButtonEntryFrameNum = 0;
+
 //variables to help with logical switches
 bool     lsDlyStarted[NUM_LOGICAL_SWITCHES];
 uint32_t lsDlyStartTime[NUM_LOGICAL_SWITCHES];
@@ -40,19 +44,299 @@ uint8_t  lsDeltaPrevInput[NUM_LOGICAL_SWITCHES];
 //array to store logical switches
 bool logicalSwitchState[NUM_LOGICAL_SWITCHES];
 
+//--- Control switch states
+//One bit per ctrl_sw_e value, so that checkSwitchCondition() is a single bit test.
+//The physical switches and trims are resolved at the start of each frame, the flight modes and 
+//logical switches as soon as they are evaluated, so a logical switch that refers to a later
+//one still sees the state of the previous frame.
+static uint8_t ctrlSwState[(CTRL_SW_COUNT + 7) / 8] = {1}; //CTRL_SW_NONE is always active
+
+//--- Logical switch order
+//The logical switches are evaluated after the ones they refer to, so a chain of them settles in
+//one frame. Switches in a reference loop, and those that depend on one, are evaluated last in
+//index order, each seeing the previous frame's state of the ones after it, as before.
+//A switch whose result only depends on its inputs is skipped when they have not changed.
+
+static uint8_t  lsOrder[NUM_LOGICAL_SWITCHES];
+static uint32_t lsInLoop = 0;       //one bit per logical switch
+static uint32_t lsInputsValid = 0;  //one bit per logical switch
+static int16_t  lsPrevInputs[NUM_LOGICAL_SWITCHES][2];
+static bool isLsOrderDirty = true;
+
+static void compileLogicalSwitchOrder();
+static bool getLogicalSwitchInputs(uint8_t idx, int16_t inputs[2]);
+static void evaluateLogicalSwitch(uint8_t idx, uint32_t _currTime);
+
+static void setCtrlSwState(uint8_t sw, bool state);
+static void writeCtrlSwStates(uint8_t sw, uint8_t count, uint8_t bits);
+static void resolvePhysicalSwitches();
+static void resolveFlightModeSwitches();
+static void resolveLogicalSwitch(uint8_t idx);
+
 bool isReinitialiseMixer = true;
 
+//--- Mixer program
+//The mixer slots that are in use, in order, with what does not change from frame to frame
+//already worked out. Rebuilt from Model.Mixer whenever the mixes may have been changed.
+//The sources are copied, so that a step never indexes with a field changed after it was built.
+
+enum {
+  MIX_OPERAND_SOURCE,  //from mixSources
+  MIX_OPERAND_COUNTER,
+  MIX_OPERAND_ZERO,    //sources that can't be used as mixer inputs
+};
+
+enum {
+  MIX_STEP_CURVE_NONE,
+  MIX_STEP_CURVE_EXPO,
+  MIX_STEP_CURVE_CUSTOM,
+  MIX_STEP_CURVE_X_GREATER_THAN_ZERO,
+  MIX_STEP_CURVE_X_LESS_THAN_ZERO,
+  MIX_STEP_CURVE_ABS_X,
+  MIX_STEP_CURVE_DIFF,
+};
+
+typedef struct {
+  uint8_t slot;       //index in Model.Mixer, and in the delay, slow and hold variables
+  uint8_t operation;
+  uint8_t input;
+  uint8_t output;
+  uint8_t operand;
+  uint8_t curve;
+  uint8_t trimSrc;    //trim to add to the output, SRC_NONE if none
+} mix_step_t;
+
+static mix_step_t mixProgram[NUM_MIX_SLOTS];
+static uint8_t mixProgramLength = 0;
+static bool isMixProgramDirty = true;
+
+//--- Curve cache
+//The curves are evaluated on their points scaled by 5, like cubicHermiteInterpolate() and
+//linearInterpolate() would do on a copy, but with the tangents of the smoothed curves worked
+//out by the background, only for the curves that have been changed. The throttle curve follows
+//the custom curves.
+
+static int32_t curveTangent[NUM_CUSTOM_CURVES + 1][MAX_NUM_POINTS_CUSTOM_CURVE];
+static uint16_t curveDirtyFlags = 0xFFFF; //one bit per curve
+
+//For a segment that is d points wide on the -100 to 100 scale, ceil(2^30 / (5 * d)).
+//(u * r) >> 20 is then exactly (1024 * u) / (5 * d) for any u from 0 to 5 * d.
+static const uint32_t curveSegmentReciprocal[201] PROGMEM = {
+  0, 214748365, 107374183, 71582789, 53687092, 42949673, 35791395, 30678338,
+  26843546, 23860930, 21474837, 19522579, 17895698, 16519105, 15339169, 14316558,
+  13421773, 12632257, 11930465, 11302546, 10737419, 10226113, 9761290, 9336886,
+  8947849, 8589935, 8259553, 7953644, 7669585, 7405117, 7158279, 6927367,
+  6710887, 6507527, 6316129, 6135668, 5965233, 5804010, 5651273, 5506369,
+  5368710, 5237765, 5113057, 4994149, 4880645, 4772186, 4668443, 4569115,
+  4473925, 4382620, 4294968, 4210753, 4129777, 4051856, 3976822, 3904516,
+  3834793, 3767516, 3702559, 3639803, 3579140, 3520465, 3463684, 3408705,
+  3355444, 3303821, 3253764, 3205200, 3158065, 3112296, 3067834, 3024625,
+  2982617, 2941759, 2902005, 2863312, 2825637, 2788940, 2753185, 2718334,
+  2684355, 2651215, 2618883, 2587330, 2556529, 2526452, 2497075, 2468373,
+  2440323, 2412903, 2386093, 2359873, 2334222, 2309123, 2284558, 2260510,
+  2236963, 2213901, 2191310, 2169176, 2147484, 2126222, 2105377, 2084936,
+  2064889, 2045223, 2025928, 2006995, 1988411, 1970169, 1952258, 1934670,
+  1917397, 1900429, 1883758, 1867378, 1851280, 1835457, 1819902, 1804609,
+  1789570, 1774780, 1760233, 1745922, 1731842, 1717987, 1704353, 1690933,
+  1677722, 1664717, 1651911, 1639301, 1626882, 1614650, 1602600, 1590729,
+  1579033, 1567507, 1556148, 1544953, 1533917, 1523039, 1512313, 1501737,
+  1491309, 1481024, 1470880, 1460874, 1451003, 1441265, 1431656, 1422175,
+  1412819, 1403585, 1394470, 1385474, 1376593, 1367824, 1359167, 1350619,
+  1342178, 1333841, 1325608, 1317475, 1309442, 1301506, 1293665, 1285919,
+  1278265, 1270701, 1263226, 1255839, 1248538, 1241321, 1234187, 1227134,
+  1220162, 1213268, 1206452, 1199712, 1193047, 1186456, 1179937, 1173489,
+  1167111, 1160802, 1154562, 1148387, 1142279, 1136235, 1130255, 1124337,
+  1118482, 1112686, 1106951, 1101274, 1095655, 1090094, 1084588, 1079138,
+  1073742,
+};
+
 //==================================================================================================
 
 void reinitialiseMixerCalculations()
 {
   isReinitialiseMixer = true;
+  isMixProgramDirty = true;
+  isLsOrderDirty = true;
+  curveDirtyFlags = 0xFFFF;
+}
+
+//==================================================================================================
+
+void markMixerProgramDirty()
+{
+  isMixProgramDirty = true;
+  isLsOrderDirty = true;
+}
+
+//==================================================================================================
+
+void markCurveDirty(uint8_t crvIdx)
+{
+  curveDirtyFlags |= (uint16_t) 1 << crvIdx;
+}
+
+//==================================================================================================
+
+void compileMixerProgram()
+{
+  mixProgramLength = 0;
+  for(uint8_t mixIdx = 0; mixIdx < NUM_MIX_SLOTS; mixIdx++)
+  {
+    mixer_params_t *mxr = &Model.Mixer[mixIdx];
+    if(mxr->output == SRC_NONE)
+      continue;
+    if(mxr->operation != MIX_HOLD && mxr->input == SRC_NONE)
+      continue;
+    
+    mix_step_t *step = &mixProgram[mixProgramLength++];
+    step->slot = mixIdx;
+    step->operation = mxr->operation;
+    step->input = mxr->input;
+    step->output = mxr->output;
+    
+    if(mxr->input < MIX_SOURCES_COUNT)
+      step->operand = MIX_OPERAND_SOURCE;
+    else if(mxr->input >= SRC_COUNTER_FIRST && mxr->input <= SRC_COUNTER_LAST)
+      step->operand = MIX_OPERAND_COUNTER;
+    else
+      step->operand = MIX_OPERAND_ZERO;
+    
+    step->curve = MIX_STEP_CURVE_NONE;
+    if(mxr->curveType == MIX_CURVE_TYPE_EXPO && mxr->curveVal != 0)
+      step->curve = MIX_STEP_CURVE_EXPO;
+    else if(mxr->curveType == MIX_CURVE_TYPE_CUSTOM)
+      step->curve = MIX_STEP_CURVE_CUSTOM;
+    else if(mxr->curveType == MIX_CURVE_TYPE_FUNCTION)
+    {
+      if(mxr->curveVal == MIX_CURVE_FUNC_X_GREATER_THAN_ZERO) step->curve = MIX_STEP_CURVE_X_GREATER_THAN_ZERO;
+      else if(mxr->curveVal == MIX_CURVE_FUNC_X_LESS_THAN_ZERO) step->curve = MIX_STEP_CURVE_X_LESS_THAN_ZERO;
+      else if(mxr->curveVal == MIX_CURVE_FUNC_ABS_X) step->curve = MIX_STEP_CURVE_ABS_X;
+    }
+    else if(mxr->curveType == MIX_CURVE_TYPE_DIFF && mxr->curveVal != 0)
+      step->curve = MIX_STEP_CURVE_DIFF;
+    
+    //the trim follows the raw stick behind the rud, thr, ail and ele sources
+    step->trimSrc = SRC_NONE;
+    if(mxr->trimEnabled)
+    {
+      uint8_t src = mxr->input;
+      if(src == SRC_RUD) src = Model.rudSrcRaw;
+      if(src == SRC_THR) src = Model.thrSrcRaw;
+      if(src == SRC_AIL) src = Model.ailSrcRaw;
+      if(src == SRC_ELE) src = Model.eleSrcRaw;
+      
+      if(src == SRC_X1_AXIS) step->trimSrc = SRC_X1_TRIM;
+      else if(src == SRC_Y1_AXIS) step->trimSrc = SRC_Y1_TRIM;
+      else if(src == SRC_X2_AXIS) step->trimSrc = SRC_X2_TRIM;
+      else if(src == SRC_Y2_AXIS) step->trimSrc = SRC_Y2_TRIM;
+    }
+  }
+  isMixProgramDirty = false;
+}
+
+//==================================================================================================
+
+void updateCurveCache()
+{
+  //Called from the background. The tangents are put in place at once, as the RC task may 
+  //come in between.
+  for(uint8_t crvIdx = 0; crvIdx <= CURVE_IDX_THROTTLE; crvIdx++)
+  {
+    uint16_t flag = (uint16_t) 1 << crvIdx;
+    if(!(curveDirtyFlags & flag))
+      continue;
+    curveDirtyFlags &= ~flag;
+    custom_curve_t *crv = (crvIdx == CURVE_IDX_THROTTLE) ? &Model.ThrottleCurve : &Model.CustomCurve[crvIdx];
+    if(!crv->smooth)
+      continue;
+    int16_t _xx[MAX_NUM_POINTS_CUSTOM_CURVE];
+    int16_t _yy[MAX_NUM_POINTS_CUSTOM_CURVE];
+    int32_t tangent[MAX_NUM_POINTS_CUSTOM_CURVE];
+    for(uint8_t pt = 0; pt < crv->numPoints; pt++)
+    {
+      _xx[pt] = 5 * crv->xVal[pt];
+      _yy[pt] = 5 * crv->yVal[pt];
+    }
+    for(uint8_t pt = 0; pt < crv->numPoints; pt++)
+      tangent[pt] = calcTangent(_xx, _yy, crv->numPoints, pt);
+    uint8_t oldSREG = SREG;
+    cli();
+    memcpy(curveTangent[crvIdx], tangent, crv->numPoints * sizeof(tangent[0]));
+    SREG = oldSREG;
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//Gives the same result as cubicHermiteInterpolate() or linearInterpolate() on the scaled points,
+//including where points share the same x value.
+
+int16_t evaluateCurve(uint8_t crvIdx, int16_t xVal)
+{
+  custom_curve_t *crv = (crvIdx == CURVE_IDX_THROTTLE) ? &Model.ThrottleCurve : &Model.CustomCurve[crvIdx];
+  uint8_t numPts = crv->numPoints;
+  int16_t xFirst = 5 * crv->xVal[0];
+  int16_t xLast = 5 * crv->xVal[numPts - 1];
+  if(xVal < xFirst)
+    return 5 * crv->yVal[0];
+  if(xVal > xLast)
+    return 5 * crv->yVal[numPts - 1];
+  
+  //find the segment, the first one that has xVal in the lower half of the curve,
+  //the last one in the upper half
+  int16_t xMid = (xFirst + xLast) / 2;
+  uint8_t i;
+  if(xVal <= xMid)
+  {
+    i = 0;
+    while(i < numPts - 2 && xVal > 5 * crv->xVal[i + 1])
+      i++;
+  }
+  else
+  {
+    i = numPts - 2;
+    while(i > 0 && xVal < 5 * crv->xVal[i])
+      i--;
+  }
+  
+  int16_t x0 = 5 * crv->xVal[i];
+  int16_t x1 = 5 * crv->xVal[i + 1];
+  int16_t y0 = 5 * crv->yVal[i];
+  int16_t y1 = 5 * crv->yVal[i + 1];
+  int16_t x = xVal;
+  
+  if(x1 <= x0) //infinite slope, or points out of order
+    return (x <= xMid) ? y0 : y1;
+  
+  int32_t dx = x1 - x0;
+  if(!crv->smooth)
+    return (((int32_t)(x - x0) * (y1 - y0)) + ((int32_t) y0 * dx)) / dx;
+  
+  const int32_t multiplier = 1024;
+  uint32_t reciprocal = pgm_read_dword(&curveSegmentReciprocal[crv->xVal[i + 1] - crv->xVal[i]]);
+  int32_t t = ((uint32_t)(x - x0) * reciprocal) >> 20;
+  int32_t tpow2 = (t * t) / multiplier;
+  int32_t tpow3 = (tpow2 * t) / multiplier;
+  
+  //hermite basis functions
+  int32_t h00 = 2*tpow3 - 3*tpow2 + multiplier;
+  int32_t h10 = tpow3 - 2*tpow2 + t;
+  int32_t h01 = -2*tpow3 + 3*tpow2;
+  int32_t h11 = tpow3 - tpow2;
+  
+  int32_t m0 = curveTangent[crvIdx][i];
+  int32_t m1 = curveTangent[crvIdx][i + 1];
+  
+  int32_t y = h00*y0 + ((h10*m0)/multiplier)*dx + h01*y1 + ((h11*m1)/multiplier)*dx;
+  return y / multiplier;
 }
 
 //==================================================================================================
 
 void computeChannelOutputs()
 {
+  resolvePhysicalSwitches();
+  
   if(isCalibratingControls)
     return;
 
@@ -60,7 +344,10 @@ void computeChannelOutputs()
   {
     //reset logical switch states here to avoid stale data in subsequent calculations 
     for(uint8_t i = 0; i < NUM_LOGICAL_SWITCHES; i++)
+    {
       logicalSwitchState[i] = false;
+      resolveLogicalSwitch(i);
+    }
     //resynchronize the waveform generators
     for(uint8_t i = 0; i < NUM_FUNCGEN; i++)
       syncWaveform(i);
@@ -80,6 +367,7 @@ void computeChannelOutputs()
   //--- Determine the activeFmdIdx 
   //The first one found true takes precedence; the subsequent ones are ignored even if their conditions are met
   activeFmdIdx = 0;
+  resolveFlightModeSwitches();
   for(uint8_t i = 0; i < NUM_FLIGHT_MODES; i++)
   {
     if(Model.FlightMode[i].swtch != CTRL_SW_NONE && checkSwitchCondition(Model.FlightMode[i].swtch))
@@ -88,10 +376,16 @@ void computeChannelOutputs()
       break;
     }
   }
+  resolveFlightModeSwitches();
   
   flight_mode_t* fmd = &Model.FlightMode[activeFmdIdx];
   
   //--- Get trim values
+  static bool isHeldButtonSeen = false;
+  if(heldButton != 0 && !isHeldButtonSeen)
+    heldButtonEntryFrameNum = rcFrameCount;
+  isHeldButtonSeen = (heldButton != 0);
+  
   //x1 axis
   if(Model.X1Trim.trimState == TRIM_COMMON)
     Model.X1Trim.commonTrim = adjustTrim(0, Model.X1Trim.commonTrim, KEY_X1_TRIM_UP, KEY_X1_TRIM_DOWN);
@@ -215,17 +509,7 @@ void computeChannelOutputs()
     mixSources[SRC_ELE] = calcRateExpo(mixSources[Model.eleSrcRaw], Model.EleDualRate.rate2, Model.EleDualRate.expo2);
   
   //Mix source Throttle curve
-  int16_t _xxQQ[MAX_NUM_POINTS_CUSTOM_CURVE];
-  int16_t _yyQQ[MAX_NUM_POINTS_CUSTOM_CURVE];
-  for(uint8_t pt = 0; pt < Model.ThrottleCurve.numPoints; pt++)
-  {
-    _xxQQ[pt] = 5 * Model.ThrottleCurve.xVal[pt];
-    _yyQQ[pt] = 5 * Model.ThrottleCurve.yVal[pt];
-  }
-  if(Model.ThrottleCurve.smooth)
-    mixSources[SRC_THR] = cubicHermiteInterpolate(_xxQQ, _yyQQ, Model.ThrottleCurve.numPoints, mixSources[Model.thrSrcRaw]);
-  else
-    mixSources[SRC_THR] = linearInterpolate(_xxQQ, _yyQQ, Model.ThrottleCurve.numPoints, mixSources[Model.thrSrcRaw]);
+  mixSources[SRC_THR] = evaluateCurve(CURVE_IDX_THROTTLE, mixSources[Model.thrSrcRaw]);
 
   //Mix source Switches
   for(uint8_t i = 0; i < NUM_PHYSICAL_SWITCHES; i++)
@@ -242,11 +526,18 @@ void computeChannelOutputs()
   for(uint8_t i = 0; i < NUM_FUNCGEN; i++)
     mixSources[SRC_FUNCGEN_FIRST + i] = generateWaveform(i, currMillis);
 
+  //Counters and logical switches are evaluated once per main loop, as at 50 Hz, so that those 
+  //clocked by the evaluations, such as a logical switch of its own negation, keep their timing 
+  //at the higher frame rates
+  bool isLoopFrame = isReinitialiseMixer || (rcFrameCount % rcFramesPerLoop) == 0;
+
   //Evaluate counters
-  evaluateCounters();
+  if(isLoopFrame)
+    evaluateCounters();
 
   //Mix sources Logical switches
-  evaluateLogicalSwitches(currMillis);
+  if(isLoopFrame)
+    evaluateLogicalSwitches(currMillis);
   for(uint8_t i = 0; i < NUM_LOGICAL_SWITCHES; i++)
     mixSources[SRC_SW_LOGICAL_FIRST + i] = logicalSwitchState[i] ? 500 : -500;
   
@@ -263,18 +554,25 @@ void computeChannelOutputs()
   
   ///----------------- MIXER LOOP ------------------------
   
-  for(uint8_t mixIdx = 0; mixIdx < NUM_MIX_SLOTS; mixIdx++)
+  if(isMixProgramDirty)
+    compileMixerProgram();
+  
+  if(isReinitialiseMixer)
+  {
+    for(uint8_t i = 0; i < NUM_MIX_SLOTS; i++)
+      hldOldState[i] = false;
+  }
+  
+  uint8_t fmdBit = 1 << activeFmdIdx;
+  
+  for(uint8_t stepIdx = 0; stepIdx < mixProgramLength; stepIdx++)
   {
+    mix_step_t *step = &mixProgram[stepIdx];
+    uint8_t mixIdx = step->slot;
     mixer_params_t *mxr = &Model.Mixer[mixIdx];
     
-    //--- CHECK OUTPUT INDEX
-    if(mxr->output == SRC_NONE)
-      continue;
-    
     //--- HANDLE SPECIAL MIXER OPERATION 'HOLD'
-    if(isReinitialiseMixer)
-      hldOldState[mixIdx] = false;
-    if(mxr->operation == MIX_HOLD)
+    if(step->operation == MIX_HOLD)
     {
       if(checkSwitchCondition(mxr->swtch))
       {
@@ -282,10 +580,10 @@ void computeChannelOutputs()
         if(!hldOldState[mixIdx])
         {
           hldOldState[mixIdx] = true;
-          hldOldVal[mixIdx] = mixSources[mxr->output];
+          hldOldVal[mixIdx] = mixSources[step->output];
         }
         //override the source with the value we captured
-        mixSources[mxr->output] = hldOldVal[mixIdx];
+        mixSources[step->output] = hldOldVal[mixIdx];
       }
       else
         hldOldState[mixIdx] = false;
@@ -293,25 +591,21 @@ void computeChannelOutputs()
       continue;
     }
     
-    //--- CHECK INPUT INDEX
-    if(mxr->input == SRC_NONE)
-      continue;
-
     //--- ASSIGN
     int16_t operand = 0;
-    if(mxr->input < MIX_SOURCES_COUNT)
-      operand = mixSources[mxr->input];
-    else if(mxr->input >= SRC_COUNTER_FIRST && mxr->input <= SRC_COUNTER_LAST)
+    if(step->operand == MIX_OPERAND_SOURCE)
+      operand = mixSources[step->input];
+    else if(step->operand == MIX_OPERAND_COUNTER)
     {
-      uint8_t counterIdx = mxr->input - SRC_COUNTER_FIRST;
+      uint8_t counterIdx = step->input - SRC_COUNTER_FIRST;
       operand = -500 + ((int32_t)counterOut[counterIdx] * 1000 / (Model.Counter[counterIdx].modulus - 1));
     }
 
     //--- DELAY
     //Reset delay variables if the input or model has been changed
-    if((mxr->input != dlyPrevInput[mixIdx]) || isReinitialiseMixer) 
+    if((step->input != dlyPrevInput[mixIdx]) || isReinitialiseMixer) 
     {
-      dlyPrevInput[mixIdx] = mxr->input;
+      dlyPrevInput[mixIdx] = step->input;
       dlyOldVal[mixIdx]  = operand;
       dlyPrevOperand[mixIdx]  = operand / 4;
       dlyStartTime[mixIdx] = currMillis;
@@ -367,53 +661,35 @@ void computeChannelOutputs()
     //--- CHECK MIXSWITCH, FLIGHT MODE
     //This is done after processing Delay and Slow so we can still update them 
     //even when the mixer condition is not met to avoid glitches due to stale values.
-    if(!checkSwitchCondition(mxr->swtch) || !((mxr->flightMode >> activeFmdIdx) & 0x01))
+    if(!(mxr->flightMode & fmdBit) || !checkSwitchCondition(mxr->swtch))
       continue;
 
     if(focusedMixIdx == mixIdx)
       focusedMixInputVal = operand;
     
     //--- CURVES
-    if(mxr->curveType == MIX_CURVE_TYPE_EXPO)
+    if(step->curve == MIX_STEP_CURVE_EXPO)
       operand = calcExpo(operand, mxr->curveVal);
-    else if(mxr->curveType == MIX_CURVE_TYPE_CUSTOM)
+    else if(step->curve == MIX_STEP_CURVE_CUSTOM)
+      operand = evaluateCurve(mxr->curveVal, operand);
+    else if(step->curve == MIX_STEP_CURVE_X_GREATER_THAN_ZERO)
     {
-      uint8_t _crvIdx = mxr->curveVal;
-      uint8_t _numPts = Model.CustomCurve[_crvIdx].numPoints;
-      int16_t _xx[MAX_NUM_POINTS_CUSTOM_CURVE];
-      int16_t _yy[MAX_NUM_POINTS_CUSTOM_CURVE];
-      for(uint8_t pt = 0; pt < _numPts; pt++)
-      {
-        _xx[pt] = 5 * Model.CustomCurve[_crvIdx].xVal[pt];
-        _yy[pt] = 5 * Model.CustomCurve[_crvIdx].yVal[pt];
-      }
-      if(Model.CustomCurve[_crvIdx].smooth)
-        operand = cubicHermiteInterpolate(_xx, _yy, _numPts, operand);
-      else
-        operand = linearInterpolate(_xx, _yy, _numPts, operand);
+      if(operand < 0) operand = 0; 
     }
-    else if(mxr->curveType == MIX_CURVE_TYPE_FUNCTION)
+    else if(step->curve == MIX_STEP_CURVE_X_LESS_THAN_ZERO)
     {
-      uint8_t _func = mxr->curveVal;
-      switch(_func)
-      {
-        case MIX_CURVE_FUNC_X_GREATER_THAN_ZERO: 
-          if(operand < 0) operand = 0; 
-          break;
-        case MIX_CURVE_FUNC_X_LESS_THAN_ZERO: 
-          if(operand > 0) operand = 0; 
-          break;
-        case MIX_CURVE_FUNC_ABS_X: 
-          if(operand < 0) operand = -operand; 
-          break;
-      }
+      if(operand > 0) operand = 0; 
+    }
+    else if(step->curve == MIX_STEP_CURVE_ABS_X)
+    {
+      if(operand < 0) operand = -operand; 
     }
     
     //--- WEIGHT, OFFSET
     operand = weightAndOffset(operand, mxr->weight, mxr->offset);
     
     //--- DIFFERENTIAL
-    if(mxr->curveType == MIX_CURVE_TYPE_DIFF && mxr->curveVal != 0)
+    if(step->curve == MIX_STEP_CURVE_DIFF)
       operand = calcDifferential(operand, mxr->curveVal);
 
     //Export for graphing purposes
@@ -426,24 +702,13 @@ void computeChannelOutputs()
     //--- TRIM
     //Apply weighted trim after differential to prevent the output being erratic when differential or
     //curves are specified and trim is non-zero.
-    if(mxr->trimEnabled)
-    {
-      uint8_t src = mxr->input;
-      if(src == SRC_RUD) src = Model.rudSrcRaw;
-      if(src == SRC_THR) src = Model.thrSrcRaw;
-      if(src == SRC_AIL) src = Model.ailSrcRaw;
-      if(src == SRC_ELE) src = Model.eleSrcRaw;
-      
-      if(src == SRC_X1_AXIS) operand += ((int32_t) mixSources[SRC_X1_TRIM] * mxr->weight) / 100; 
-      else if(src == SRC_Y1_AXIS) operand += ((int32_t) mixSources[SRC_Y1_TRIM] * mxr->weight) / 100; 
-      else if(src == SRC_X2_AXIS) operand += ((int32_t) mixSources[SRC_X2_TRIM] * mxr->weight) / 100; 
-      else if(src == SRC_Y2_AXIS) operand += ((int32_t) mixSources[SRC_Y2_TRIM] * mxr->weight) / 100; 
-    }
+    if(step->trimSrc != SRC_NONE)
+      operand += ((int32_t) mixSources[step->trimSrc] * mxr->weight) / 100; 
     
     //--- MIX AND UPDATE
     operand = constrain(operand, -500, 500); 
-    int32_t output = mixSources[mxr->output];
-    switch(mxr->operation)
+    int32_t output = mixSources[step->output];
+    switch(step->operation)
     {
       case MIX_ADD:
         output += operand;
@@ -460,7 +725,7 @@ void computeChannelOutputs()
     }
     output = constrain(output, -500, 500); 
     //update for next iteration
-    mixSources[mxr->output] = (int16_t) output;
+    mixSources[step->output] = (int16_t) output;
   }
   
   ///----------------- OUTPUT TO CHANNELS ----------------
@@ -470,21 +735,7 @@ void computeChannelOutputs()
     channelOut[i] = mixSources[SRC_CH1 + i];
     //curve
     if(Model.Channel[i].curve != -1)
-    {
-      uint8_t _crvIdx = Model.Channel[i].curve;
-      uint8_t _numPts = Model.CustomCurve[_crvIdx].numPoints;
-      int16_t _xx[MAX_NUM_POINTS_CUSTOM_CURVE];
-      int16_t _yy[MAX_NUM_POINTS_CUSTOM_CURVE];
-      for(uint8_t pt = 0; pt < _numPts; pt++)
-      {
-        _xx[pt] = 5 * Model.CustomCurve[_crvIdx].xVal[pt];
-        _yy[pt] = 5 * Model.CustomCurve[_crvIdx].yVal[pt];
-      }
-      if(Model.CustomCurve[_crvIdx].smooth)
-        channelOut[i] = cubicHermiteInterpolate(_xx, _yy, _numPts, channelOut[i]);
-      else
-        channelOut[i] = linearInterpolate(_xx, _yy, _numPts, channelOut[i]);
-    }
+      channelOut[i] = evaluateCurve(Model.Channel[i].curve, channelOut[i]);
     //reverse
     if(Model.Channel[i].reverse) 
       channelOut[i] = 0 - channelOut[i]; 
@@ -564,6 +815,8 @@ void moveMix(uint8_t newPos, uint8_t oldPos)
   slowCurrVal[newPos]     = tempSlowCurrVal;
   hldOldVal[newPos]       = tempHldOldVal;
   hldOldState[newPos]     = tempHldOldState;
+  
+  isMixProgramDirty = true;
 }
 
 //==================================================================================================
@@ -602,6 +855,8 @@ void swapMix(uint8_t posA, uint8_t posB)
   slowCurrVal[posB]     = tempSlowCurrVal;
   hldOldVal[posB]       = tempHldOldVal;
   hldOldState[posB]     = tempHldOldState;
+  
+  isMixProgramDirty = true;
 }
 
 //==================================================================================================
@@ -713,12 +968,172 @@ bool moveLogicalSwitch(uint8_t newPos, uint8_t oldPos)
   lsDeltaPrevVal[newPos]      = tempLsDeltaPrevVal;
   lsDeltaPrevInput[newPos]    = tempLsDeltaPrevInput;
   logicalSwitchState[newPos]  = tempLogicalSwitchState;
+  
+  for(uint8_t i = 0; i < NUM_LOGICAL_SWITCHES; i++)
+    resolveLogicalSwitch(i);
+  
+  //the references in the mixes have changed as well
+  isMixProgramDirty = true;
+  isLsOrderDirty = true;
 
   return true;
 }
 
 //==================================================================================================
 
+static void compileLogicalSwitchOrder()
+{
+  //the logical switches each one refers to, one bit per logical switch
+  uint32_t refs[NUM_LOGICAL_SWITCHES];
+  for(uint8_t idx = 0; idx < NUM_LOGICAL_SWITCHES; idx++)
+  {
+    logical_switch_t *ls = &Model.LogicalSwitch[idx];
+    int16_t sw[2] = {CTRL_SW_NONE, CTRL_SW_NONE};
+    if(ls->func >= LS_FUNC_AND && ls->func <= LS_FUNC_LATCH)
+    {
+      sw[0] = ls->val1;
+      sw[1] = ls->val2;
+    }
+    else if(ls->func == LS_FUNC_TOGGLE) //clock and clear
+    {
+      sw[0] = ls->val1;
+      sw[1] = ls->val3;
+    }
+    refs[idx] = 0;
+    for(uint8_t i = 0; i < 2; i++)
+    {
+      if(sw[i] >= CTRL_SW_LOGICAL_FIRST && sw[i] <= CTRL_SW_LOGICAL_LAST)
+        refs[idx] |= (uint32_t) 1 << (sw[i] - CTRL_SW_LOGICAL_FIRST);
+      else if(sw[i] >= CTRL_SW_LOGICAL_FIRST_INVERT && sw[i] <= CTRL_SW_LOGICAL_LAST_INVERT)
+        refs[idx] |= (uint32_t) 1 << (sw[i] - CTRL_SW_LOGICAL_FIRST_INVERT);
+    }
+  }
+  
+  //Repeatedly take the lowest numbered switch whose references have all been placed,
+  //so that switches keep their index order where the references allow it
+  uint32_t placed = 0;
+  uint8_t count = 0;
+  bool found = true;
+  while(found)
+  {
+    found = false;
+    for(uint8_t idx = 0; idx < NUM_LOGICAL_SWITCHES; idx++)
+    {
+      uint32_t bit = (uint32_t) 1 << idx;
+      if(!(placed & bit) && !(refs[idx] & ~placed))
+      {
+        lsOrder[count++] = idx;
+        placed |= bit;
+        found = true;
+        break;
+      }
+    }
+  }
+  
+  //What is left is in a loop or depends on one
+  lsInLoop = 0;
+  for(uint8_t idx = 0; idx < NUM_LOGICAL_SWITCHES; idx++)
+  {
+    uint32_t bit = (uint32_t) 1 << idx;
+    if(!(placed & bit))
+    {
+      lsOrder[count++] = idx;
+      lsInLoop |= bit;
+    }
+  }
+  //leave out the ones that no switch in a loop refers to, until only the loops remain
+  bool dropped = true;
+  while(dropped)
+  {
+    dropped = false;
+    for(uint8_t idx = 0; idx < NUM_LOGICAL_SWITCHES; idx++)
+    {
+      uint32_t bit = (uint32_t) 1 << idx;
+      if(!(lsInLoop & bit))
+        continue;
+      bool isReferenced = false;
+      for(uint8_t i = 0; i < NUM_LOGICAL_SWITCHES; i++)
+      {
+        if((lsInLoop & ((uint32_t) 1 << i)) && (refs[i] & bit))
+          isReferenced = true;
+      }
+      if(!isReferenced)
+      {
+        lsInLoop &= ~bit;
+        dropped = true;
+      }
+    }
+  }
+  
+  lsInputsValid = 0;
+  isLsOrderDirty = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool isLogicalSwitchInLoop(uint8_t idx)
+{
+  return idx < NUM_LOGICAL_SWITCHES && (lsInLoop & ((uint32_t) 1 << idx));
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//Gets what the result of a logical switch depends on, for the ones that depend on nothing else.
+//Returns false for those that have to be evaluated every time: the ones that change with time,
+//with a delay or duration, and the delta function, which moves its reference value.
+
+static bool getLogicalSwitchInputs(uint8_t idx, int16_t inputs[2])
+{
+  logical_switch_t *ls = &Model.LogicalSwitch[idx];
+  uint8_t func = ls->func;
+  
+  if(func == LS_FUNC_NONE)
+  {
+    inputs[0] = 0;
+    inputs[1] = 0;
+    return true;
+  }
+  if(ls->val3 > 0 && func != LS_FUNC_PULSE && func != LS_FUNC_TOGGLE && func != LS_FUNC_ABS_DELTA_GREATER_THAN_X)
+    return false; //delay
+  if(ls->val4 > 0 && func != LS_FUNC_PULSE && func != LS_FUNC_LATCH && func != LS_FUNC_TOGGLE)
+    return false; //duration
+  
+  if(func <= LS_FUNC_GROUP2_LAST)
+  {
+    if(ls->val1 < MIX_SOURCES_COUNT)
+      inputs[0] = mixSources[ls->val1];
+    else if(ls->val1 >= SRC_COUNTER_FIRST && ls->val1 <= SRC_COUNTER_LAST)
+      inputs[0] = counterOut[ls->val1 - SRC_COUNTER_FIRST];
+    else //timers, telemetry, inactivity, battery
+      return false;
+    inputs[1] = 0;
+    return true;
+  }
+  if(func <= LS_FUNC_GROUP3_LAST || func == LS_FUNC_PULSE)
+    return false;
+  if(func <= LS_FUNC_GROUP4_LAST)
+  {
+    inputs[0] = mixSources[ls->val1];
+    inputs[1] = mixSources[ls->val2];
+    return true;
+  }
+  if(func <= LS_FUNC_GROUP5_LAST)
+  {
+    inputs[0] = checkSwitchCondition(ls->val1);
+    inputs[1] = checkSwitchCondition(ls->val2);
+    return true;
+  }
+  if(func == LS_FUNC_TOGGLE) //clock and clear
+  {
+    inputs[0] = checkSwitchCondition(ls->val1);
+    inputs[1] = checkSwitchCondition(ls->val3);
+    return true;
+  }
+  return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 void evaluateLogicalSwitches(uint32_t _currTime)
 {
   if(isReinitialiseMixer)
@@ -733,288 +1148,314 @@ void evaluateLogicalSwitches(uint32_t _currTime)
       if(ls->func == LS_FUNC_ABS_DELTA_GREATER_THAN_X)
         lsDeltaPrevInput[idx] = 0xFF;
     }
+    lsInputsValid = 0;
   }
-    
-  for(uint8_t idx = 0; idx < NUM_LOGICAL_SWITCHES; idx++)
+  
+  if(isLsOrderDirty)
+    compileLogicalSwitchOrder();
+  
+  for(uint8_t i = 0; i < NUM_LOGICAL_SWITCHES; i++)
   {
-    logical_switch_t *ls = &Model.LogicalSwitch[idx];
-    
-    bool result = false;
-    
-    switch(ls->func)
+    uint8_t idx = lsOrder[i];
+    uint32_t bit = (uint32_t) 1 << idx;
+    int16_t inputs[2];
+    if(getLogicalSwitchInputs(idx, inputs))
     {
-      case LS_FUNC_A_GREATER_THAN_X:
-      case LS_FUNC_A_LESS_THAN_X:
-      case LS_FUNC_A_EQUAL_X:
-      case LS_FUNC_A_GREATER_THAN_OR_EQUAL_X:
-      case LS_FUNC_A_LESS_THAN_OR_EQUAL_X:
-      case LS_FUNC_ABS_A_GREATER_THAN_X:
-      case LS_FUNC_ABS_A_LESS_THAN_X:
-      case LS_FUNC_ABS_A_EQUAL_X:
-      case LS_FUNC_ABS_A_GREATER_THAN_OR_EQUAL_X:
-      case LS_FUNC_ABS_A_LESS_THAN_OR_EQUAL_X:
-      case LS_FUNC_ABS_DELTA_GREATER_THAN_X:
+      if((lsInputsValid & bit) && inputs[0] == lsPrevInputs[idx][0] && inputs[1] == lsPrevInputs[idx][1])
+        continue;
+      lsPrevInputs[idx][0] = inputs[0];
+      lsPrevInputs[idx][1] = inputs[1];
+      lsInputsValid |= bit;
+    }
+    else
+      lsInputsValid &= ~bit;
+    
+    evaluateLogicalSwitch(idx, _currTime);
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+static void evaluateLogicalSwitch(uint8_t idx, uint32_t _currTime)
+{
+  logical_switch_t *ls = &Model.LogicalSwitch[idx];
+  
+  bool result = false;
+  
+  switch(ls->func)
+  {
+    case LS_FUNC_A_GREATER_THAN_X:
+    case LS_FUNC_A_LESS_THAN_X:
+    case LS_FUNC_A_EQUAL_X:
+    case LS_FUNC_A_GREATER_THAN_OR_EQUAL_X:
+    case LS_FUNC_A_LESS_THAN_OR_EQUAL_X:
+    case LS_FUNC_ABS_A_GREATER_THAN_X:
+    case LS_FUNC_ABS_A_LESS_THAN_X:
+    case LS_FUNC_ABS_A_EQUAL_X:
+    case LS_FUNC_ABS_A_GREATER_THAN_OR_EQUAL_X:
+    case LS_FUNC_ABS_A_LESS_THAN_OR_EQUAL_X:
+    case LS_FUNC_ABS_DELTA_GREATER_THAN_X:
+      {
+        int32_t _val1 = 0, _val2 = 0;
+        if(ls->val1 < MIX_SOURCES_COUNT) //mix sources
         {
-          int32_t _val1 = 0, _val2 = 0;
-          if(ls->val1 < MIX_SOURCES_COUNT) //mix sources
-          {
-            _val1 = mixSources[ls->val1];
-            _val2 = 5 * ls->val2;
-          }
-          else if(ls->val1 >= SRC_COUNTER_FIRST && ls->val1 <= SRC_COUNTER_LAST) //counters
-          {
-            _val1 = counterOut[ls->val1 - SRC_COUNTER_FIRST];
-            _val2 = ls->val2;
-          }
-          else if(ls->val1 >= SRC_TIMER_FIRST && ls->val1 <= SRC_TIMER_LAST) //timers
+          _val1 = mixSources[ls->val1];
+          _val2 = 5 * ls->val2;
+        }
+        else if(ls->val1 >= SRC_COUNTER_FIRST && ls->val1 <= SRC_COUNTER_LAST) //counters
+        {
+          _val1 = counterOut[ls->val1 - SRC_COUNTER_FIRST];
+          _val2 = ls->val2;
+        }
+        else if(ls->val1 >= SRC_TIMER_FIRST && ls->val1 <= SRC_TIMER_LAST) //timers
+        {
+          uint8_t tmrIdx = ls->val1 - SRC_TIMER_FIRST;
+          if(Model.Timer[tmrIdx].initialSeconds == 0) //a count up timer
           {
-            uint8_t tmrIdx = ls->val1 - SRC_TIMER_FIRST;
-            if(Model.Timer[tmrIdx].initialSeconds == 0) //a count up timer
-            {
-              _val1 = timerElapsedTime[tmrIdx];
-            }
-            else //count down timer
-            {
-              _val1 = (int32_t)Model.Timer[tmrIdx].initialSeconds * 1000;
-              _val1 -= timerElapsedTime[tmrIdx];
-            }
-            _val2 = (int32_t)ls->val2 * 1000;
+            _val1 = timerElapsedTime[tmrIdx];
           }
-          else if(ls->val1 >= SRC_TELEMETRY_FIRST && ls->val1 <= SRC_TELEMETRY_LAST)//telemetry
+          else //count down timer
           {
-            uint8_t tlmIdx = ls->val1 - SRC_TELEMETRY_FIRST;
-            if(telemetryReceivedValue[tlmIdx] == TELEMETRY_NO_DATA)
-              break; 
-            else
-            {
-              _val1 = ((int32_t) telemetryReceivedValue[tlmIdx] * Model.Telemetry[tlmIdx].multiplier) / 100;
-              _val1 += Model.Telemetry[tlmIdx].offset;
-              _val2 = ls->val2;
-            }
+            _val1 = (int32_t)Model.Timer[tmrIdx].initialSeconds * 1000;
+            _val1 -= timerElapsedTime[tmrIdx];
           }
-          else if(ls->val1 == SRC_INACTIVITY_TIMER)
+          _val2 = (int32_t)ls->val2 * 1000;
+        }
+        else if(ls->val1 >= SRC_TELEMETRY_FIRST && ls->val1 <= SRC_TELEMETRY_LAST)//telemetry
+        {
+          uint8_t tlmIdx = ls->val1 - SRC_TELEMETRY_FIRST;
+          if(telemetryReceivedValue[tlmIdx] == TELEMETRY_NO_DATA)
+            break; 
+          else
           {
-            // _val1 = _currTime - inputsLastMovedTime;
-            _val1 = millis() - inputsLastMovedTime;
-            _val2 = (int32_t)ls->val2 * 1000;
+            _val1 = ((int32_t) telemetryReceivedValue[tlmIdx] * Model.Telemetry[tlmIdx].multiplier) / 100;
+            _val1 += Model.Telemetry[tlmIdx].offset;
+            _val2 = ls->val2;
           }
-          else if(ls->val1 == SRC_TX_BATTERY_VOLTAGE)
+        }
+        else if(ls->val1 == SRC_INACTIVITY_TIMER)
+        {
+          // _val1 = _currTime - inputsLastMovedTime;
+          _val1 = millis() - inputsLastMovedTime;
+          _val2 = (int32_t)ls->val2 * 1000;
+        }
+        else if(ls->val1 == SRC_TX_BATTERY_VOLTAGE)
+        {
+          _val1 = batteryVoltsNow;
+          _val2 = ls->val2;
+        }
+        
+        if(ls->func == LS_FUNC_A_GREATER_THAN_X)                result = _val1 > _val2;
+        else if(ls->func == LS_FUNC_A_LESS_THAN_X)              result = _val1 < _val2;
+        else if(ls->func == LS_FUNC_A_EQUAL_X)                  result = _val1 == _val2;
+        else if(ls->func == LS_FUNC_A_GREATER_THAN_OR_EQUAL_X)  result = _val1 >= _val2;
+        else if(ls->func == LS_FUNC_A_LESS_THAN_OR_EQUAL_X)     result = _val1 <= _val2;
+        else if(ls->func == LS_FUNC_ABS_A_GREATER_THAN_X)       result = abs(_val1) > _val2;
+        else if(ls->func == LS_FUNC_ABS_A_LESS_THAN_X)          result = abs(_val1) < _val2;
+        else if(ls->func == LS_FUNC_ABS_A_EQUAL_X)              result = abs(_val1) == _val2;
+        else if(ls->func == LS_FUNC_ABS_A_GREATER_THAN_OR_EQUAL_X) result = abs(_val1) >= _val2;
+        else if(ls->func == LS_FUNC_ABS_A_LESS_THAN_OR_EQUAL_X) result = abs(_val1) <= _val2;
+        else if(ls->func == LS_FUNC_ABS_DELTA_GREATER_THAN_X)
+        {
+          if(lsDeltaPrevInput[idx] != ls->val1) //reinitialise
           {
-            _val1 = batteryVoltsNow;
-            _val2 = ls->val2;
+            lsDeltaPrevInput[idx] = ls->val1;
+            lsDeltaPrevVal[idx] = _val1;
           }
-          
-          if(ls->func == LS_FUNC_A_GREATER_THAN_X)                result = _val1 > _val2;
-          else if(ls->func == LS_FUNC_A_LESS_THAN_X)              result = _val1 < _val2;
-          else if(ls->func == LS_FUNC_A_EQUAL_X)                  result = _val1 == _val2;
-          else if(ls->func == LS_FUNC_A_GREATER_THAN_OR_EQUAL_X)  result = _val1 >= _val2;
-          else if(ls->func == LS_FUNC_A_LESS_THAN_OR_EQUAL_X)     result = _val1 <= _val2;
-          else if(ls->func == LS_FUNC_ABS_A_GREATER_THAN_X)       result = abs(_val1) > _val2;
-          else if(ls->func == LS_FUNC_ABS_A_LESS_THAN_X)          result = abs(_val1) < _val2;
-          else if(ls->func == LS_FUNC_ABS_A_EQUAL_X)              result = abs(_val1) == _val2;
-          else if(ls->func == LS_FUNC_ABS_A_GREATER_THAN_OR_EQUAL_X) result = abs(_val1) >= _val2;
-          else if(ls->func == LS_FUNC_ABS_A_LESS_THAN_OR_EQUAL_X) result = abs(_val1) <= _val2;
-          else if(ls->func == LS_FUNC_ABS_DELTA_GREATER_THAN_X)
+
+          int32_t difference = _val1 - lsDeltaPrevVal[idx];
+          if(abs(difference) > _val2)
           {
-            if(lsDeltaPrevInput[idx] != ls->val1) //reinitialise
+            if(ls->val3 == 0) //only in positive direction
             {
-              lsDeltaPrevInput[idx] = ls->val1;
-              lsDeltaPrevVal[idx] = _val1;
+              if(difference > _val2)
+                result = true;
+              if(result || difference < 0)
+                lsDeltaPrevVal[idx] = _val1;
             }
-
-            int32_t difference = _val1 - lsDeltaPrevVal[idx];
-            if(abs(difference) > _val2)
+            else if(ls->val3 == 1) //only in negative direction
             {
-              if(ls->val3 == 0) //only in positive direction
-              {
-                if(difference > _val2)
-                  result = true;
-                if(result || difference < 0)
-                  lsDeltaPrevVal[idx] = _val1;
-              }
-              else if(ls->val3 == 1) //only in negative direction
-              {
-                if(difference < -_val2)
-                  result = true;
-                if(result || difference > 0)
-                  lsDeltaPrevVal[idx] = _val1;
-              }
-              else //both directions
-              {
+              if(difference < -_val2)
                 result = true;
+              if(result || difference > 0)
                 lsDeltaPrevVal[idx] = _val1;
-              }
+            }
+            else //both directions
+            {
+              result = true;
+              lsDeltaPrevVal[idx] = _val1;
             }
           }
         }
-        break;
+      }
+      break;
 
-      case LS_FUNC_A_GREATER_THAN_B:
-        result = mixSources[ls->val1] > mixSources[ls->val2];
-        break;
+    case LS_FUNC_A_GREATER_THAN_B:
+      result = mixSources[ls->val1] > mixSources[ls->val2];
+      break;
+    
+    case LS_FUNC_A_LESS_THAN_B:
+      result = mixSources[ls->val1] < mixSources[ls->val2];
+      break;
       
-      case LS_FUNC_A_LESS_THAN_B:
-        result = mixSources[ls->val1] < mixSources[ls->val2];
-        break;
-        
-      case LS_FUNC_A_EQUAL_B:
-        result = mixSources[ls->val1] == mixSources[ls->val2];
-        break;
-        
-      case LS_FUNC_A_GREATER_THAN_OR_EQUAL_B:
-        result = mixSources[ls->val1] >= mixSources[ls->val2];
-        break;
-        
-      case LS_FUNC_A_LESS_THAN_OR_EQUAL_B:
-        result = mixSources[ls->val1] <= mixSources[ls->val2];
-        break;
-        
-      case LS_FUNC_AND:
-        result = checkSwitchCondition(ls->val1) && checkSwitchCondition(ls->val2);
-        break;
-         
-      case LS_FUNC_OR:
-        result = checkSwitchCondition(ls->val1) || checkSwitchCondition(ls->val2);
-        break;
-        
-      case LS_FUNC_XOR:
-        result = checkSwitchCondition(ls->val1) != checkSwitchCondition(ls->val2);
-        break;
-        
-      case LS_FUNC_LATCH:
-        {
-          bool _val1 = checkSwitchCondition(ls->val1);
-          bool _val2 = checkSwitchCondition(ls->val2);
-          if(_val1 && !_val2) result = true;       //set
-          else if(!_val1 && _val2) result = false; //reset
-          else result = logicalSwitchState[idx];   //no change
-        }
-        break;
-        
-      case LS_FUNC_TOGGLE:
+    case LS_FUNC_A_EQUAL_B:
+      result = mixSources[ls->val1] == mixSources[ls->val2];
+      break;
+      
+    case LS_FUNC_A_GREATER_THAN_OR_EQUAL_B:
+      result = mixSources[ls->val1] >= mixSources[ls->val2];
+      break;
+      
+    case LS_FUNC_A_LESS_THAN_OR_EQUAL_B:
+      result = mixSources[ls->val1] <= mixSources[ls->val2];
+      break;
+      
+    case LS_FUNC_AND:
+      result = checkSwitchCondition(ls->val1) && checkSwitchCondition(ls->val2);
+      break;
+       
+    case LS_FUNC_OR:
+      result = checkSwitchCondition(ls->val1) || checkSwitchCondition(ls->val2);
+      break;
+      
+    case LS_FUNC_XOR:
+      result = checkSwitchCondition(ls->val1) != checkSwitchCondition(ls->val2);
+      break;
+      
+    case LS_FUNC_LATCH:
+      {
+        bool _val1 = checkSwitchCondition(ls->val1);
+        bool _val2 = checkSwitchCondition(ls->val2);
+        if(_val1 && !_val2) result = true;       //set
+        else if(!_val1 && _val2) result = false; //reset
+        else result = logicalSwitchState[idx];   //no change
+      }
+      break;
+      
+    case LS_FUNC_TOGGLE:
+      {
+        //get the previous result
+        result = logicalSwitchState[idx]; 
+        //get the state of the switch, the source of our clock
+        bool state = checkSwitchCondition(ls->val1);
+        //toggle on the rising edge
+        if(ls->val2 == 0) 
         {
-          //get the previous result
-          result = logicalSwitchState[idx]; 
-          //get the state of the switch, the source of our clock
-          bool state = checkSwitchCondition(ls->val1);
-          //toggle on the rising edge
-          if(ls->val2 == 0) 
+          if(state && !lsToggleLastState[idx]) //went from low to high
           {
-            if(state && !lsToggleLastState[idx]) //went from low to high
-            {
-              lsToggleLastState[idx] = true;
-              result = !logicalSwitchState[idx];
-            }
-            else if(!state)
-              lsToggleLastState[idx] = false;
-          }
-          //toggle on falling edge
-          if(ls->val2 == 1) 
-          {
-            if(!state && lsToggleLastState[idx]) //went from high to low
-            {
-              lsToggleLastState[idx] = false;
-              result = !logicalSwitchState[idx];
-            }
-            else if(state)
-              lsToggleLastState[idx] = true;
-          }
-          //dual edge triggering i.e. both rising and falling edges
-          if(ls->val2 == 2)
-          {
-            if(state != lsToggleLastState[idx])
-            {
-              lsToggleLastState[idx] = state;
-              result = !logicalSwitchState[idx];
-            }
+            lsToggleLastState[idx] = true;
+            result = !logicalSwitchState[idx];
           }
-          
-          //clear. This overrides result to false.
-          if(ls->val3 != CTRL_SW_NONE && checkSwitchCondition(ls->val3))
-            result = false;
+          else if(!state)
+            lsToggleLastState[idx] = false;
         }
-        break;
-        
-      case LS_FUNC_PULSE:
+        //toggle on falling edge
+        if(ls->val2 == 1) 
         {
-          uint32_t highTime   = (uint32_t)ls->val1 * 100;
-          uint32_t period     = (uint32_t)ls->val2 * 100;
-          uint32_t pulseDelay = (uint32_t)ls->val3 * 100;
-          uint32_t timeInstance;
-          //As we are dealing with unsigned subtraction, we need to prevent strange results here
-          //because at start up, the value of _currTime is less than that of pulseDelay.
-          if(_currTime >= pulseDelay)
-            timeInstance = (_currTime - pulseDelay) % period;
-          else
+          if(!state && lsToggleLastState[idx]) //went from high to low
           {
-            timeInstance = period - ((pulseDelay - _currTime) % period); 
-            timeInstance %= period;
+            lsToggleLastState[idx] = false;
+            result = !logicalSwitchState[idx];
           }
-          result = timeInstance < highTime;
+          else if(state)
+            lsToggleLastState[idx] = true;
         }
-        break;
-    }
-    
-    //delay
-    //here we delay activation of the logical switch by overriding for the specified time
-    if(ls->val3 > 0)
-    {
-      if(ls->func != LS_FUNC_NONE 
-         && ls->func != LS_FUNC_PULSE 
-         && ls->func != LS_FUNC_TOGGLE 
-         && ls->func != LS_FUNC_ABS_DELTA_GREATER_THAN_X)
-      {
-        if(result && !logicalSwitchState[idx]) //went from false to true
+        //dual edge triggering i.e. both rising and falling edges
+        if(ls->val2 == 2)
         {
-          if(!lsDlyStarted[idx])
+          if(state != lsToggleLastState[idx])
           {
-            lsDlyStartTime[idx] = _currTime;
-            lsDlyStarted[idx] = true;
+            lsToggleLastState[idx] = state;
+            result = !logicalSwitchState[idx];
           }
         }
-        if(!result) //reset flag
-          lsDlyStarted[idx] = false;
-          
-        if(_currTime - lsDlyStartTime[idx] < ((uint32_t)ls->val3 * 100)) //override result
+        
+        //clear. This overrides result to false.
+        if(ls->val3 != CTRL_SW_NONE && checkSwitchCondition(ls->val3))
           result = false;
       }
-      else
+      break;
+      
+    case LS_FUNC_PULSE:
       {
-        lsDlyStarted[idx] = false;
+        uint32_t highTime   = (uint32_t)ls->val1 * 100;
+        uint32_t period     = (uint32_t)ls->val2 * 100;
+        uint32_t pulseDelay = (uint32_t)ls->val3 * 100;
+        uint32_t timeInstance;
+        //As we are dealing with unsigned subtraction, we need to prevent strange results here
+        //because at start up, the value of _currTime is less than that of pulseDelay.
+        if(_currTime >= pulseDelay)
+          timeInstance = (_currTime - pulseDelay) % period;
+        else
+        {
+          timeInstance = period - ((pulseDelay - _currTime) % period); 
+          timeInstance %= period;
+        }
+        result = timeInstance < highTime;
       }
-    }
-    
-    //duration
-    if(ls->val4 > 0)
+      break;
+  }
+  
+  //delay
+  //here we delay activation of the logical switch by overriding for the specified time
+  if(ls->val3 > 0)
+  {
+    if(ls->func != LS_FUNC_NONE 
+       && ls->func != LS_FUNC_PULSE 
+       && ls->func != LS_FUNC_TOGGLE 
+       && ls->func != LS_FUNC_ABS_DELTA_GREATER_THAN_X)
     {
-      if(ls->func != LS_FUNC_NONE 
-         && ls->func != LS_FUNC_PULSE 
-         && ls->func != LS_FUNC_LATCH 
-         && ls->func != LS_FUNC_TOGGLE)
+      if(result && !logicalSwitchState[idx]) //went from false to true
       {
-        if(result && !lsDurOldState[idx]) //went from inactive to active
+        if(!lsDlyStarted[idx])
         {
-          lsDurOldState[idx] = true;
-          lsDurEndTime[idx] = _currTime + ((uint32_t)ls->val4 * 100); 
-        }
-        if(_currTime >= lsDurEndTime[idx]) //duration has expired
-        {
-          if(!result) //only reset old state when result goes false
-            lsDurOldState[idx] = false;
-          result = false;
+          lsDlyStartTime[idx] = _currTime;
+          lsDlyStarted[idx] = true;
         }
-        else if(lsDurOldState[idx]) //hold even if the input suddenly became false before duration expired
-          result = true;
       }
-      else
+      if(!result) //reset flag
+        lsDlyStarted[idx] = false;
+        
+      if(_currTime - lsDlyStartTime[idx] < ((uint32_t)ls->val3 * 100)) //override result
+        result = false;
+    }
+    else
+    {
+      lsDlyStarted[idx] = false;
+    }
+  }
+  
+  //duration
+  if(ls->val4 > 0)
+  {
+    if(ls->func != LS_FUNC_NONE 
+       && ls->func != LS_FUNC_PULSE 
+       && ls->func != LS_FUNC_LATCH 
+       && ls->func != LS_FUNC_TOGGLE)
+    {
+      if(result && !lsDurOldState[idx]) //went from inactive to active
+      {
+        lsDurOldState[idx] = true;
+        lsDurEndTime[idx] = _currTime + ((uint32_t)ls->val4 * 100); 
+      }
+      if(_currTime >= lsDurEndTime[idx]) //duration has expired
       {
-        lsDurOldState[idx] = false;
+        if(!result) //only reset old state when result goes false
+          lsDurOldState[idx] = false;
+        result = false;
       }
+      else if(lsDurOldState[idx]) //hold even if the input suddenly became false before duration expired
+        result = true;
+    }
+    else
+    {
+      lsDurOldState[idx] = false;
     }
-
-    //store the result
-    logicalSwitchState[idx] = result;
   }
+
+  //store the result
+  logicalSwitchState[idx] = result;
+  resolveLogicalSwitch(idx);
 }
 
 //==================================================================================================
@@ -1175,12 +1616,23 @@ void evaluateCounters()
 
 //==================================================================================================
 
+//Same as n / 100 for n from -50000 to 50000. The AVR has no hardware divider, so we multiply
+//by 2^23/100 rounded up and shift instead, which for this range of n is exact.
+
+static inline int32_t divBy100(int32_t n)
+{
+  uint32_t q = ((uint32_t)((n < 0) ? -n : n) * 83887UL) >> 23;
+  return (n < 0) ? -(int32_t)q : (int32_t)q;
+}
+
+//==================================================================================================
+
 int16_t calcRateExpo(int16_t input, int16_t rate, int16_t expo)
 {
   /* This function is for applying rate and cubic 'expo' to aileron, elevator and rudder.
      Ranges: input -500 to 500, rate 0 to 100, expo -100 to 100. 0 is linear
   */
-  return ((int32_t)rate * calcExpo(input, expo)) / 100;
+  return divBy100((int32_t)rate * calcExpo(input, expo));
 }
 
 //==================================================================================================
@@ -1205,23 +1657,34 @@ int16_t calcExpo(int16_t input, int16_t expo)
   
   Simplifying and rearranging to ensure no overflow for our range of values,
   y = (((k*x*x + 250000*(100-k))/250000)*x)/100
+  
+  The first division leaves q = (k*x*x)/250000 + (100-k), a whole number from 0 to 100. Rather than 
+  dividing, we estimate (k*x*x)/250000 as (k*x*x*134) >> 25, which is never more than 1 too low 
+  for our range of values, and correct it by comparing back. Then y = (x*q)/100 is at most 50000/100 
+  and done with divBy100(). The result is the same as with the divisions.
+  For negative k, x is taken from 500 downwards, y = 500 - ((k*x*x + 250000*(100-k))/250000)*x/100.
   */
   
   if(expo == 0)
     return input;
 
-  int32_t x = abs(input);
-  int32_t k = abs(expo);
+  uint32_t x = abs(input);
+  uint32_t k = abs(expo);
+  if(x > 500)
+    x = 500;
   if(expo < 0)
-    x -= 500;
+    x = 500 - x;
+  
+  uint32_t kxx = k*x*x;
+  uint32_t q = (kxx * 134) >> 25;
+  if((q + 1) * 250000 <= kxx)
+    q++;
+  q += 100 - k;
   
-  int32_t y = k*x*x + 250000*(100-k);
-  y /= 250000;
-  y *= x;
-  y /= 100;
+  int32_t y = divBy100(x * q);
   
   if(expo < 0)
-    y += 500;
+    y = 500 - y;
   if(input < 0)
     y = -y;
   
@@ -1253,14 +1716,14 @@ int32_t applySlow(int32_t currVal, int32_t targetVal, int32_t range, int32_t mul
 {
   if(currVal < targetVal && riseTime > 0)
   {
-    int32_t step = (multiplier * range * fixedLoopTime) / riseTime;
+    int32_t step = (multiplier * range * fixedLoopTime) / (riseTime * rcFramesPerLoop);
     currVal += step;
     if(currVal > targetVal)
       currVal = targetVal;
   }
   else if(currVal > targetVal && fallTime > 0) 
   {
-    int32_t step = (multiplier * range * fixedLoopTime) / fallTime;
+    int32_t step = (multiplier * range * fixedLoopTime) / (fallTime * rcFramesPerLoop);
     currVal -= step;
     if(currVal < targetVal)
       currVal = targetVal;
@@ -1282,69 +1745,62 @@ int16_t weightAndOffset(int16_t input, int16_t weight, int16_t offset)
 
 bool checkSwitchCondition(uint8_t sw)
 {
-  bool result = false;
-  
-  if(sw == CTRL_SW_NONE) //always active
-  {
-    result = true;
-  }
-  else if(sw >= CTRL_SW_PHYSICAL_FIRST && sw <= CTRL_SW_PHYSICAL_LAST)
-  {
-    uint8_t idx = (sw - CTRL_SW_PHYSICAL_FIRST) / 6;
-    uint8_t condition = (sw - CTRL_SW_PHYSICAL_FIRST) % 6;
-    switch(condition) //up, mid, down, !up, !mid, !down
-    {
-      case 0: result = swState[idx] == SWUPPERPOS; break;
-      case 1: result = swState[idx] == SWMIDPOS;   break; 
-      case 2: result = swState[idx] == SWLOWERPOS; break;
-      case 3: result = swState[idx] != SWUPPERPOS; break;
-      case 4: result = swState[idx] != SWMIDPOS;   break;
-      case 5: result = swState[idx] != SWLOWERPOS; break;
-    }
-  }
-  else if(sw >= CTRL_SW_LOGICAL_FIRST && sw <= CTRL_SW_LOGICAL_LAST_INVERT)
-  {
-    bool invertResult = false;
-    uint8_t idx = sw - CTRL_SW_LOGICAL_FIRST;
-    if(sw >= CTRL_SW_LOGICAL_FIRST_INVERT)
-    {
-      idx = sw - CTRL_SW_LOGICAL_FIRST_INVERT;
-      invertResult = true;
-    }
-    //check within array
-    result = logicalSwitchState[idx];
-    
-    if(invertResult)
-      result = !result;
-  }
-  else if(sw >= CTRL_SW_FMD_FIRST && sw <= CTRL_SW_FMD_LAST_INVERT)
-  {
-    bool invertResult = false;
-    uint8_t fmdIdx = sw - CTRL_SW_FMD_FIRST;
-    if(fmdIdx >= NUM_FLIGHT_MODES)
-    {      
-      fmdIdx -= NUM_FLIGHT_MODES;
-      invertResult = true;
-    }
-    //compare with active flight mode
-    if(fmdIdx == activeFmdIdx) 
-      result = true;
-    if(invertResult)
-      result = !result;
-  }
-  else if(sw >= CTRL_SW_TRIM_FIRST && sw <= CTRL_SW_TRIM_LAST)
-  {
-    if(sw == CTRL_SW_X1_TRIM_LEFT && buttonCode == KEY_X1_TRIM_DOWN) result = true;
-    else if(sw == CTRL_SW_X1_TRIM_RIGHT && buttonCode == KEY_X1_TRIM_UP) result = true;
-    else if(sw == CTRL_SW_Y1_TRIM_UP && buttonCode == KEY_Y1_TRIM_UP) result = true;
-    else if(sw == CTRL_SW_Y1_TRIM_DOWN && buttonCode == KEY_Y1_TRIM_DOWN) result = true;
-    else if(sw == CTRL_SW_X2_TRIM_LEFT && buttonCode == KEY_X2_TRIM_DOWN) result = true;
-    else if(sw == CTRL_SW_X2_TRIM_RIGHT && buttonCode == KEY_X2_TRIM_UP) result = true;
-    else if(sw == CTRL_SW_Y2_TRIM_UP && buttonCode == KEY_Y2_TRIM_UP) result = true;
-    else if(sw == CTRL_SW_Y2_TRIM_DOWN && buttonCode == KEY_Y2_TRIM_DOWN) result = true;
-  }
+  if(sw >= CTRL_SW_COUNT)
+    return false;
+  return ctrlSwState[sw >> 3] & (1 << (sw & 7));
+}
+
+//--------------------------------------------------------------------------------------------------
+
+static void setCtrlSwState(uint8_t sw, bool state)
+{
+  if(state)
+    ctrlSwState[sw >> 3] |= (1 << (sw & 7));
+  else
+    ctrlSwState[sw >> 3] &= ~(1 << (sw & 7));
+}
+
+//Writes up to 8 bits at once, starting with the one for sw
+static void writeCtrlSwStates(uint8_t sw, uint8_t count, uint8_t bits)
+{
+  uint8_t idx = sw >> 3;
+  uint16_t mask = ((1 << count) - 1) << (sw & 7);
+  uint16_t val = ((uint16_t) bits << (sw & 7)) & mask;
+  ctrlSwState[idx] = (ctrlSwState[idx] & ~(uint8_t) mask) | (uint8_t) val;
+  if(mask >> 8)
+    ctrlSwState[idx + 1] = (ctrlSwState[idx + 1] & ~(uint8_t)(mask >> 8)) | (uint8_t)(val >> 8);
+}
+
+static void resolvePhysicalSwitches()
+{
+  //up, mid, down, !up, !mid, !down, for each of SWUPPERPOS, SWLOWERPOS, SWMIDPOS
+  static const uint8_t swConditions[3] = {0x31, 0x1C, 0x2A};
+  for(uint8_t i = 0; i < NUM_PHYSICAL_SWITCHES; i++)
+    writeCtrlSwStates(CTRL_SW_PHYSICAL_FIRST + (i * 6), 6, swConditions[swState[i]]);
   
-  return result;
+  uint8_t trims = 0;
+  if(buttonCode == KEY_X1_TRIM_DOWN)      trims = 1 << (CTRL_SW_X1_TRIM_LEFT - CTRL_SW_TRIM_FIRST);
+  else if(buttonCode == KEY_X1_TRIM_UP)   trims = 1 << (CTRL_SW_X1_TRIM_RIGHT - CTRL_SW_TRIM_FIRST);
+  else if(buttonCode == KEY_Y1_TRIM_UP)   trims = 1 << (CTRL_SW_Y1_TRIM_UP - CTRL_SW_TRIM_FIRST);
+  else if(buttonCode == KEY_Y1_TRIM_DOWN) trims = 1 << (CTRL_SW_Y1_TRIM_DOWN - CTRL_SW_TRIM_FIRST);
+  else if(buttonCode == KEY_X2_TRIM_DOWN) trims = 1 << (CTRL_SW_X2_TRIM_LEFT - CTRL_SW_TRIM_FIRST);
+  else if(buttonCode == KEY_X2_TRIM_UP)   trims = 1 << (CTRL_SW_X2_TRIM_RIGHT - CTRL_SW_TRIM_FIRST);
+  else if(buttonCode == KEY_Y2_TRIM_UP)   trims = 1 << (CTRL_SW_Y2_TRIM_UP - CTRL_SW_TRIM_FIRST);
+  else if(buttonCode == KEY_Y2_TRIM_DOWN) trims = 1 << (CTRL_SW_Y2_TRIM_DOWN - CTRL_SW_TRIM_FIRST);
+  writeCtrlSwStates(CTRL_SW_TRIM_FIRST, 8, trims);
+}
+
+static void resolveFlightModeSwitches()
+{
+  uint8_t active = 1 << activeFmdIdx;
+  writeCtrlSwStates(CTRL_SW_FMD_FIRST, NUM_FLIGHT_MODES, active);
+  writeCtrlSwStates(CTRL_SW_FMD_FIRST_INVERT, NUM_FLIGHT_MODES, ~active);
+}
+
+static void resolveLogicalSwitch(uint8_t idx)
+{
+  setCtrlSwState(CTRL_SW_LOGICAL_FIRST + idx, logicalSwitchState[idx]);
+  setCtrlSwState(CTRL_SW_LOGICAL_FIRST_INVERT + idx, !logicalSwitchState[idx]);
 }
 
 //==================================================================================================
@@ -1379,16 +1835,17 @@ int16_t adjustTrim(uint8_t idx, int16_t val, uint8_t incButton, uint8_t decButto
       step = STEP_VAL_MEDIUM;
   }
 
-  if((thisLoopNum - heldButtonEntryLoopNum) % (_repeatDelay / fixedLoopTime) == 0) 
+  //counted in RC frames, as the mixer runs in the RC task
+  if((rcFrameCount - heldButtonEntryFrameNum) % ((_repeatDelay / fixedLoopTime) * rcFramesPerLoop) == 0) 
     _heldBtn = heldButton;
   
   //briefly pause at the center
   static bool paused[4];
-  static uint32_t pausedLoopNum[4];
+  static uint32_t pausedFrameNum[4];
   if(val == 0 && _heldBtn && !paused[idx])
   {
     paused[idx] = true;
-    pausedLoopNum[idx] = thisLoopNum;
+    pausedFrameNum[idx] = rcFrameCount;
   }
   if(val != 0)
   {
@@ -1396,7 +1853,7 @@ int16_t adjustTrim(uint8_t idx, int16_t val, uint8_t incButton, uint8_t decButto
   }
   if(paused[idx])
   {
-    if((thisLoopNum - pausedLoopNum[idx]) < ((uint32_t) Sys.longPressDelay / fixedLoopTime))
+    if((rcFrameCount - pausedFrameNum[idx]) < ((uint32_t) Sys.longPressDelay / fixedLoopTime) * rcFramesPerLoop)
       _heldBtn = 0;
   }
   
@@ -1457,7 +1914,18 @@ int16_t adjustTrim(uint8_t idx, int16_t val, uint8_t incButton, uint8_t decButto
 
 //==================================================================================================
 
-bool isSyncWaveform[NUM_FUNCGEN];
+//--- Function generators
+//Each generator has a phase accumulator, where 2^32 is one period, advanced by the time since the 
+//last frame at a rate worked out when the period changes. With phase compensation the phase simply
+//carries on when the period changes. With a fixed phase, the phase is instead taken from the time 
+//since the mixer was initialised, so generators with the same period keep their phase difference.
+
+static bool     isSyncWaveform[NUM_FUNCGEN];
+static int32_t  fgenPeriod[NUM_FUNCGEN];      //in ms, 0 until run
+static uint32_t fgenPhaseInc[NUM_FUNCGEN];    //phase increment per ms
+static uint32_t fgenPhase[NUM_FUNCGEN];
+static uint32_t fgenPrevPhase[NUM_FUNCGEN];
+static int32_t  fgenLastTime[NUM_FUNCGEN];
 
 void syncWaveform(uint8_t idx)
 {
@@ -1490,18 +1958,9 @@ int16_t generateWaveform(uint8_t idx, int32_t _currTime)
       period = (((m + 500) * (fgen->period2 - fgen->period1)) / 10) + ((int32_t)fgen->period1 * 100);
     }
   }
+  if(period < 1)
+    period = 1;
   
-  static int32_t oldPeriod[NUM_FUNCGEN];
-  static int32_t timeOffset[NUM_FUNCGEN];
-  
-  int32_t timeInstance = 0; 
-  
-  if(isSyncWaveform[idx])
-  {
-    isSyncWaveform[idx] = false;
-    timeOffset[idx] = 0;
-  }
-
   bool phaseCompensate = false;
   
   if(fgen->waveform == FUNCGEN_WAVEFORM_PULSE)
@@ -1517,39 +1976,33 @@ int16_t generateWaveform(uint8_t idx, int32_t _currTime)
       phaseCompensate = true;
     }
   }
-
-  if(phaseCompensate)
+  
+  //advance the phase
+  if(isSyncWaveform[idx] || fgenPeriod[idx] == 0 || (!phaseCompensate && period != fgenPeriod[idx]))
   {
-    // Smoothly transition to new period when the period is being adjusted.
-    // We add some time offset so that we maintain the next ratio of timeInstance/period upon change.
-    if(period != oldPeriod[idx])
-    {
-      if(oldPeriod[idx] == 0) //at initial run
-      {
-        timeOffset[idx] = 0;
-        oldPeriod[idx] = period; 
-      }
-      else
-      {
-        int32_t nextTimeInstance = (_currTime + timeOffset[idx]) % oldPeriod[idx];
-        timeOffset[idx] = ((period * nextTimeInstance)/oldPeriod[idx]) - (_currTime % period);
-        oldPeriod[idx] = period; 
-      }
-    }
-    timeInstance = (_currTime + timeOffset[idx]) % period;
+    isSyncWaveform[idx] = false;
+    fgenPeriod[idx] = period;
+    fgenPhaseInc[idx] = (0xFFFFFFFFUL / period) + 1;
+    fgenPhase[idx] = (uint32_t)(_currTime % period) * fgenPhaseInc[idx];
+    fgenPrevPhase[idx] = fgenPhase[idx];
   }
-  else //fixed phase
+  else
   {
-    timeOffset[idx] = ((int32_t) fgen->phase * period) / 360;
-    if(_currTime >= timeOffset[idx])
-      timeInstance = (_currTime - timeOffset[idx]) % period;
-    else
+    //wraps around at the end of each period
+    fgenPhase[idx] += (uint32_t)(_currTime - fgenLastTime[idx]) * fgenPhaseInc[idx];
+    if(period != fgenPeriod[idx]) //from the next frame on, at the new rate
     {
-      timeInstance = period - ((timeOffset[idx] - _currTime) % period); 
-      timeInstance %= period;
+      fgenPeriod[idx] = period;
+      fgenPhaseInc[idx] = (0xFFFFFFFFUL / period) + 1;
     }
   }
-
+  fgenLastTime[idx] = _currTime;
+  
+  uint32_t phase = fgenPhase[idx];
+  if(!phaseCompensate)
+    phase -= (uint32_t)fgen->phase * 11930465UL; //2^32 / 360
+  uint16_t phase16 = phase >> 16;
+  
   switch(fgen->waveform)
   {
     case FUNCGEN_WAVEFORM_SINE:
@@ -1573,64 +2026,63 @@ int16_t generateWaveform(uint8_t idx, int32_t _currTime)
           -191, -180, -168, -157, -145, -133, -121, -110, -98, -85, -73, -61, -49, -37, -25, -12
         };
 
-        //--fixed point arithmetic with a fractional part
-        // the fractional part is used for linear interpolation
+        //the top 8 bits of the phase index the table, the next 5 bits interpolate
         const int16_t multiplier = 32;
-        int16_t index = (timeInstance * (sizeof(sineTable)/sizeof(sineTable[0])) * multiplier) / period; 
-        uint16_t indexLUT = index / multiplier;
+        uint8_t indexLUT = phase >> 24;
+        int16_t frac = (phase >> 19) & (multiplier - 1);
         int16_t valL = (int16_t)pgm_read_word(&sineTable[indexLUT]);
-        indexLUT++;
-        if(indexLUT >= (sizeof(sineTable)/sizeof(sineTable[0]))) 
-          indexLUT = 0;
+        indexLUT++; //wraps around to 0
         int16_t valR = (int16_t)pgm_read_word(&sineTable[indexLUT]);
-        result = valL + (((valR - valL)*(index % multiplier)) / multiplier);
+        result = valL + (((valR - valL) * frac) / multiplier);
       }
       break;
     
     case FUNCGEN_WAVEFORM_SAWTOOTH:
       {
-        if(timeInstance < (period/2))
-          result = map(timeInstance, 0, period/2, 0, 500);
-        else
-          result = map(timeInstance, period/2, period, -500, 0);
+        //0 to 500 over the first half, -500 to 0 over the second
+        int16_t val = ((uint32_t)phase16 * 1000) >> 16;
+        result = (val < 500) ? val : val - 1000;
       }
       break;
     
     case FUNCGEN_WAVEFORM_TRIANGLE:
       {
-        if(timeInstance < (period/4))
-          result = map(timeInstance, 0, period/4, 0, 500);
-        else if(timeInstance < ((3 * period)/4))
-          result = map(timeInstance, period/4, (3 * period)/4, 500, -500);
+        //0 to 500 over the first quarter, down to -500 at three quarters, then back to 0
+        int16_t val = ((uint32_t)phase16 * 2000) >> 16;
+        if(val < 500)
+          result = val;
+        else if(val < 1500)
+          result = 1000 - val;
         else
-          result = map(timeInstance, (3 * period)/4, period, -500, 0);
+          result = val - 2000;
       }
       break;
     
     case FUNCGEN_WAVEFORM_SQUARE:
       {
-        result = timeInstance < (period/2) ? 500 : -500;
+        result = (phase < 0x80000000UL) ? 500 : -500;
       }
       break;
 
     case FUNCGEN_WAVEFORM_PULSE:
       {
         if(fgen->widthMode == FUNCGEN_PULSE_WIDTH_FIXED)
-          result = (timeInstance < ((int32_t)fgen->width * 100)) ? 500 : -500;
+        {
+          uint32_t width = (uint32_t)fgen->width * 100;
+          result = (width >= (uint32_t)period || phase < width * fgenPhaseInc[idx]) ? 500 : -500;
+        }
         else if(fgen->widthMode == FUNCGEN_PULSE_WIDTH_VARIABLE)
         {
           //duty cycle is only updated at the end of the PWM cycle to prevent glitches.
-          static int32_t prevTimeInstance[NUM_FUNCGEN];
           static int16_t modulatorValue[NUM_FUNCGEN];
-          if(timeInstance < prevTimeInstance[idx])
+          if(phase < fgenPrevPhase[idx])
           {
             modulatorValue[idx] = mixSources[fgen->modulatorSrc];
             if(fgen->reverseModulator)
               modulatorValue[idx] = 0 - modulatorValue[idx];
           }
-          prevTimeInstance[idx] = timeInstance;
-          int32_t highTime = ((modulatorValue[idx] + 500) * period) / 1000;
-          result = (timeInstance < highTime) ? 500 : -500;
+          uint32_t highPhase = (uint32_t)(modulatorValue[idx] + 500) * 4294967UL; //2^32 / 1000
+          result = (phase < highPhase) ? 500 : -500;
         }
       }
       break;
@@ -1639,18 +2091,19 @@ int16_t generateWaveform(uint8_t idx, int32_t _currTime)
       {
         static bool isExpired[NUM_FUNCGEN];
         static int16_t lastResult[NUM_FUNCGEN];
-        if(timeInstance < (period/2) && isExpired[idx])
+        if(phase < 0x80000000UL && isExpired[idx])
         {
           isExpired[idx] = false;
           lastResult[idx] = random(-500, 500);
         }
-        if(timeInstance >= (period/2))
+        if(phase >= 0x80000000UL)
           isExpired[idx] = true;
         
         result = lastResult[idx];
       }
       break;
   }
+  fgenPrevPhase[idx] = phase;
   
   result = constrain(result, -500, 500);
   return result;
@@ -1,6 +1,8 @@
 #ifndef _MIXER_H_
 #define _MIXER_H_
 
+#define CURVE_IDX_THROTTLE  NUM_CUSTOM_CURVES
+
 void computeChannelOutputs();
 
 int16_t calcRateExpo(int16_t input, int16_t rate, int16_t expo);
@@ -11,8 +13,12 @@ bool checkSwitchCondition(uint8_t sw);
 void moveMix(uint8_t newPos, uint8_t oldPos);
 void swapMix(uint8_t posA, uint8_t posB);
 bool moveLogicalSwitch(uint8_t newPos, uint8_t oldPos);
+bool isLogicalSwitchInLoop(uint8_t idx);
 void syncWaveform(uint8_t idx);
 void reinitialiseMixerCalculations();
+void markMixerProgramDirty();
+void markCurveDirty(uint8_t crvIdx); //CURVE_IDX_THROTTLE for the throttle curve
+void updateCurveCache();             //from the background, rebuilds the curves marked dirty
 int16_t adjustTrim(uint8_t idx, int16_t val, uint8_t incButton, uint8_t decButton);
 
 extern int16_t mixSources[MIX_SOURCES_COUNT]; 
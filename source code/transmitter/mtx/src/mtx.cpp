@@ -1,20 +1,51 @@
 
 #include "Arduino.h"
+#include <avr/interrupt.h>
 
 #include "../config.h"
 #include "common.h"
-#include "crc.h"
 #include "inputs.h"
 #include "mathHelpers.h"
 #include "mixer.h"
+#include "profiler.h"
+#include "rcPacking.h"
+#include "uartMessage.h"
 #include "ee/eestore.h"
 #include "sd/sdStore.h"
 #include "ui/ui.h"
+#include "ui/uiCommon.h"
 #include "mtx.h"
 
 uint32_t loopStartTime; //in microseconds
-
-#define UART_FIXED_PACKET_SIZE 48
+static uint32_t inputsSampleTime; //in microseconds, when the inputs of the RC data were read
+
+static volatile bool    isRcTaskStarted = false;
+static volatile bool    isRcTaskBusy = false;
+static volatile uint8_t mixerHoldCount = 0;
+static volatile uint8_t rcFrameNum = 0; //only for telling frames apart, wraps
+static uint8_t loopFrameNum = 0;
+
+//A message from the secondary MCU, parsed by the RC task and handled by the background. It sends 
+//a couple of telemetry messages per downlink slot and a status now and then, far fewer than loops.
+static uart_message_t mcuMessage;
+static volatile bool  hasMcuMessage = false;
+
+//Timer1 runs at clk/8, counting 2 ticks per microsecond
+static volatile uint16_t rcTaskTimerTicks = fixedLoopTime * 2000U;
+
+//The frame rates. Each RC frame is a whole fraction of the main loop, so the main loop keeps its 
+//period. The number of channels is limited to what fits in the RC packet at the LoRa settings 
+//used by the secondary MCU and the receiver for the frame rate.
+typedef struct {
+  uint8_t framesPerLoop;
+  uint8_t maxChannels;
+} frame_rate_profile_t;
+
+static const frame_rate_profile_t frameRateProfile[RF_FRAME_RATE_COUNT] PROGMEM = {
+  {1, NUM_RC_CHANNELS},           //50 Hz
+  {2, MAX_CHANNELS_PER_RECEIVER}, //100 Hz
+  {3, 8}                          //150 Hz
+};
 
 enum {
   MESSAGE_TYPE_NONE = 0x00,
@@ -38,7 +69,12 @@ enum {
 
 void controlBacklight();
 void doSerialCommunication();
+uint8_t getRCChannelResolution(uint8_t chIdx, bool isMixed);
+uint8_t fitRCChannels(uint8_t numChannels, uint16_t maxBits, bool isMixed, uint16_t *numBits);
+void handleSecondaryMcuMessage(const uart_message_t *msg);
+bool takeSecondaryMcuMessage(uart_message_t *msg);
 void handleTelemetry();
+void startRcTask();
 
 //==================================================================================================
 
@@ -61,7 +97,8 @@ void setup()
   initialiseSwitches();
 
   //initialise serial ports 
-  Serial1.begin(115200); 
+  Serial.begin(115200);  //debug output
+  Serial1.begin(UART_BAUD_RATE); 
   
   //delay a bit to allow time for other devices to be ready
   delay(100);
@@ -143,6 +180,9 @@ void setup()
   //Other initialisations
   randomSeed(batteryVoltsNow);
   reinitialiseMixerCalculations();
+  updateCurveCache();
+  startRcTask();
+  loopFrameNum = rcFrameNum;
   loopStartTime = micros();
 
 }
@@ -151,20 +191,40 @@ void setup()
 
 void loop()
 {
+  //The background loop. The inputs, the mixer and the RC data are handled by the RC task, see 
+  //below, so nothing here holds up the RC data. This loop runs every fixedLoopTime, i.e. once 
+  //every rcFramesPerLoop frames, so the counts of loops here are the same at any frame rate.
+  
   thisLoopNum++;
 
-  ///--- SWITCHES, BUTTONS
+  ///--- BUTTON EVENTS
+  //The buttons are as the RC task last read them, taken once so they stay the same for the loop
   readSwitchesAndButtons();
   determineButtonEvent();
-  
-  ///--- STICKS 
-  readSticks();
-  
-  ///--- COMPUTE OUTPUTS
-  computeChannelOutputs();
+
+  ///--- TELEMETRY
+  profBegin(PROF_STAGE_TELEMETRY);
+  uart_message_t msg;
+  if(takeSecondaryMcuMessage(&msg))
+    handleSecondaryMcuMessage(&msg);
+  handleTelemetry();
+  profEnd(PROF_STAGE_TELEMETRY);
   
   ///--- HANDLE MAIN INTERFACE
+  //The UI changes the model while a value is being edited, moved sources included, and in 
+  //response to the navigation keys, loading a model included. Hold the mixer meanwhile, so it 
+  //never works with a half changed model.
+  bool isEditing = isEditMode
+                   || (buttonCode != 0 && !(buttonCode >= KEY_TRIM_FIRST && buttonCode <= KEY_TRIM_LAST))
+                   || (clickedButton != 0 && !(clickedButton >= KEY_TRIM_FIRST && clickedButton <= KEY_TRIM_LAST));
+  if(isEditing)
+    holdMixer();
+  profBegin(PROF_STAGE_UI);
   handleMainUI();
+  profEnd(PROF_STAGE_UI);
+  updateCurveCache(); //before the mixer works with the curves changed
+  if(isEditing)
+    releaseMixer();
   
   ///--- LAZY SAVE MODEL DATA TO EEPROM
   //Limit calling to about 10 times per second to prolong the EEPROM life.
@@ -172,45 +232,163 @@ void loop()
   //Without the limit, the same would take approximately 48 seconds, so if we let the system run
   //for 6 hours, we would be making 450 writes to a certain EEPROM cell, compared to 90 when limited.
   if(thisLoopNum % (100 / fixedLoopTime) == 0)
+  {
+    profBegin(PROF_STAGE_EEPROM);
     eeLazyWriteModelData(Sys.activeModelIdx);
+    profEnd(PROF_STAGE_EEPROM);
+  }
 
   ///--- LAZY SAVE SYSTEM DATA TO EEPROM
   //The cycle time set to about 5 minutes
   const uint32_t intervalMillis = 300000UL / sizeof(Sys); 
   if(thisLoopNum % (intervalMillis / fixedLoopTime) == 0)
+  {
+    profBegin(PROF_STAGE_EEPROM);
     eeLazyWriteSysConfig();
+    profEnd(PROF_STAGE_EEPROM);
+  }
+  
+  ///--- BACKLIGHT
+  controlBacklight();
+  
+  ///--- HANDLE POWER OFF 
+  handlePowerOff();
   
-  ///--- LIMIT MAX RATE OF LOOP
-  //This is done here for a more consistent timing of communications.
+  ///--- WAIT FOR THE NEXT LOOP
   //Code section changed to use micros() instead of millis().
   //Rollover isn't a problem here. 
   uint32_t loopTime = micros() - loopStartTime;
   if(Sys.showLoopTime) //debug
     DBG_loopTime = loopTime;
-  if(loopTime < (fixedLoopTime * 1000)) 
-    delayMicroseconds((fixedLoopTime * 1000) - loopTime);
+  profRecordFrame(loopTime);
+  while((uint8_t)(rcFrameNum - loopFrameNum) < rcFramesPerLoop)
+    delayMicroseconds(100);
+  loopFrameNum = rcFrameNum;
   loopStartTime = micros(); 
+}
 
+//==================================================================================================
+//============================ RC task =============================================================
+
+//The RC task runs from the Timer1 compare match interrupt, at the frame rate set. It reads the 
+//inputs, computes the outputs and sends the RC data to the secondary MCU, whatever the background 
+//loop is doing, blocking screens included. Interrupts stay enabled, so the UARTs and millis() 
+//keep working while it runs.
+//
+//Shared data:
+//- The RC task owns the inputs (switches, buttons, sticks, knobs, battery voltage), the mixer 
+//  state and outputs (mixSources, channelOut), and the link to the secondary MCU. Once it runs,
+//  the input reading functions do nothing when called from the background, which only reads the 
+//  results. The calibration screens have the ADC to themselves, as the mixer is then idle anyway.
+//- The background owns Model and Sys. While it may be changing the model, it holds the mixer with
+//  holdMixer()/releaseMixer(), and the RC task keeps sending the last outputs.
+//- The RC task parses the messages from the secondary MCU into a one message mailbox, leaving 
+//  the next in the UART buffer until the background has taken it. The background handles them,
+//  as they write the telemetry and the last known position into Model.
+//- The RC task reads the buttons, the background takes them over into buttonCode when it calls
+//  readSwitchesAndButtons(), so that they don't change under the UI.
+//As the RC task interrupts the background and never the other way round, the background never 
+//sees the outputs of a half computed frame.
+
+void startRcTask()
+{
+  TCCR1A = 0;           //normal counting mode
+  TCCR1B = _BV(CS11);   //prescaler of 8
+  OCR1A = TCNT1 + rcTaskTimerTicks;
+  TIFR1 |= _BV(OCF1A);  //clear any pending interrupt
+  isRcTaskStarted = true;
+  TIMSK1 |= _BV(OCIE1A);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+static void runRcTask()
+{
+  rcFrameCount++;
+  
+  ///--- FRAME RATE
+  //A change takes effect from the next frame on
+  rcFramesPerLoop = pgm_read_byte(&frameRateProfile[Sys.rfFrameRate].framesPerLoop);
+  rcTaskTimerTicks = (fixedLoopTime * 2000U) / rcFramesPerLoop;
+  
+  ///--- SWITCHES, BUTTONS
+  inputsSampleTime = micros();
+  profBegin(PROF_STAGE_SWITCHES);
+  readSwitchesAndButtons();
+  profEnd(PROF_STAGE_SWITCHES);
+  
+  ///--- STICKS 
+  profBegin(PROF_STAGE_STICKS);
+  readSticks();
+  profEnd(PROF_STAGE_STICKS);
+  
+  ///--- COMPUTE OUTPUTS
+  if(mixerHoldCount == 0)
+  {
+    profBegin(PROF_STAGE_MIXER);
+    computeChannelOutputs();
+    profEnd(PROF_STAGE_MIXER);
+  }
+  
   ///--- COMMUNICATIONS
+  profBegin(PROF_STAGE_SERIAL);
   doSerialCommunication();
-
-  ///--- TELEMETRY
-  handleTelemetry();
+  profEnd(PROF_STAGE_SERIAL);
   
   ///--- CHECK BATTERY
-  checkBattery();
-  
-  ///--- BACKLIGHT
-  controlBacklight();
+  if(!isCalibratingControls)
+    checkBattery();
   
-  ///--- HANDLE POWER OFF 
-  handlePowerOff();
+  rcFrameNum++;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+ISR(TIMER1_COMPA_vect, ISR_NOBLOCK)
+{
+  OCR1A += rcTaskTimerTicks;
+  if(isRcTaskBusy) //still running the last frame
+  {
+    profCountOverrun();
+    return;
+  }
+  isRcTaskBusy = true;
+  runRcTask();
+  isRcTaskBusy = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool isInputsOwner()
+{
+  return !isRcTaskStarted || isRcTaskBusy;
+}
+
+bool isInRcTask()
+{
+  return isRcTaskBusy;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void holdMixer()
+{
+  mixerHoldCount++;
+}
+
+void releaseMixer()
+{
+  if(mixerHoldCount > 0)
+    mixerHoldCount--;
 }
 
 //==================================================================================================
 
 void checkBattery()
 {
+  if(!isInputsOwner())
+    return;
+  
   //Low pass filtered using exponential smoothing
   //As the implementation here uses integer math and the technique is recursive, 
   //there is loss of precision but this doesn't matter much here.
@@ -281,8 +459,8 @@ void controlBacklight()
 
 void doSerialCommunication()
 {
-  uint8_t buffer[UART_FIXED_PACKET_SIZE];
-  memset(buffer, 0, sizeof(buffer));
+  uart_message_t msg;
+  memset(&msg, 0, sizeof(msg));
   
   ///------------- SEND TO SECONDARY MCU --------------
 
@@ -311,10 +489,17 @@ void doSerialCommunication()
   switch(messageType)
   {
     case MESSAGE_TYPE_ENTER_BIND:
+      {
+        dataLength = 1;
+        msg.data[0] = isMainReceiver ? 1 : 0;
+        msg.data[0] |= (Sys.rfFrameRate & 0x03) << 1; //the receiver keeps the frame rate it is bound with
+      }
+      break;
+      
     case MESSAGE_TYPE_GET_RECEIVER_CONFIG:
       {
         dataLength = 1;
-        buffer[5] = isMainReceiver ? 1 : 0;
+        msg.data[0] = isMainReceiver ? 1 : 0;
       }
       break;
     
@@ -322,10 +507,9 @@ void doSerialCommunication()
       {
         for(uint8_t i = 0; i < MAX_CHANNELS_PER_RECEIVER; i++)
         {
-          buffer[5 + i] = outputChConfig[i];
+          msg.data[i] = outputChConfig[i];
         }
-        uint8_t flagsIdx = 5 + MAX_CHANNELS_PER_RECEIVER;
-        buffer[flagsIdx] = isMainReceiver ? 1 : 0;
+        msg.data[MAX_CHANNELS_PER_RECEIVER] = isMainReceiver ? 1 : 0;
         dataLength = MAX_CHANNELS_PER_RECEIVER + 1;
       }
       break;
@@ -334,30 +518,44 @@ void doSerialCommunication()
       {
         bool isRequestingTelemetry = false;
         bool isFailsafeData = false;
-        uint8_t qq = thisLoopNum % 64;
-        if(qq == 16) //send failsafe data
+        //same cadence at all frame rates, a cycle being 1.28 seconds
+        uint8_t cycleLength = 64 * rcFramesPerLoop;
+        uint8_t qq = rcFrameCount % cycleLength;
+        if(qq == cycleLength / 4) //send failsafe data
           isFailsafeData = true;
-        else if(qq == 0 || qq == 32) //request telemetry
+
+        //Telemetry is wanted on every frame when necessary i.e. if there are configured sensors
+        //or we are forcing telemetry request. stx then plans the slots for the receiver to reply.
+        if(telemetryForceRequest)
+          isRequestingTelemetry = true;
+        else
         {
-          //only request telemetry when necessary i.e. if there are configured sensors
-          //or we are forcing telemetry request
-          if(telemetryForceRequest)
-            isRequestingTelemetry = true;
-          else
+          for(uint8_t i = 0; i < NUM_CUSTOM_TELEMETRY; i++)
           {
-            for(uint8_t i = 0; i < NUM_CUSTOM_TELEMETRY; i++)
+            if(!isEmptyStr(Model.Telemetry[i].name, sizeof(Model.Telemetry[0].name))) 
             {
-              if(!isEmptyStr(Model.Telemetry[i].name, sizeof(Model.Telemetry[0].name))) 
-              {
-                isRequestingTelemetry = true;
-                break;
-              }
+              isRequestingTelemetry = true;
+              break;
             }
           }
         }
 
+        //Sent are the channels that fit in the bits of maxChannels at full resolution. With mixed 
+        //resolution, where switch channels take fewer bits, more may fit or the packet may be 
+        //shorter. Failsafe data is always at full resolution, to carry Hold and No pulse.
         uint8_t numChannels = Model.secondaryRcvrEnabled ? NUM_RC_CHANNELS : MAX_CHANNELS_PER_RECEIVER;
-
+        uint8_t maxChannels = pgm_read_byte(&frameRateProfile[Sys.rfFrameRate].maxChannels);
+        uint16_t maxBits = ((maxChannels * 10 + 7) / 8) * 8;
+        uint16_t numBits, numMixedBits = 0;
+        uint8_t numFullChannels = fitRCChannels(numChannels, maxBits, false, &numBits);
+        uint8_t numMixedChannels = 0;
+        if(!isFailsafeData)
+          numMixedChannels = fitRCChannels(numChannels, maxBits, true, &numMixedBits);
+        bool isMixed = numMixedChannels > numFullChannels 
+                       || (numMixedChannels == numFullChannels && (numMixedBits + 7) / 8 < (numBits + 7) / 8);
+        numChannels = isMixed ? numMixedChannels : numFullChannels;
+
+        uint16_t values[NUM_RC_CHANNELS];
         for(uint8_t chIdx = 0; chIdx < numChannels; chIdx++)
         {
           uint16_t val = 0;
@@ -380,92 +578,117 @@ void doSerialCommunication()
             val = channelOut[chIdx] + 500; 
           }
 
-          //encode into bit stream, with resolution of 10 bits
-          uint8_t aIdx = chIdx + (chIdx / 4);
-          uint8_t bIdx = aIdx + 1;
-          uint8_t aShift = ((chIdx % 4) + 1) * 2;
-          uint8_t bShift = 8 - aShift;
-          buffer[5 + aIdx] |= ((val >> aShift) & 0xFF);
-          buffer[5 + bIdx] |= ((val << bShift) & 0xFF);
+          values[chIdx] = val;
         }
 
-        dataLength = ((((numChannels * 10) + 7) / 8) + 1); // +1 is for the flags byte
+        //encode into bit stream
+        uint16_t bitPos = 0;
+        if(isMixed)
+        {
+          for(uint8_t chIdx = 0; chIdx < numChannels; chIdx++)
+            packRCChannel(msg.data, &bitPos, values[chIdx], getRCChannelResolution(chIdx, true), true);
+        }
+        else
+        {
+          packFullRCChannels(msg.data, values, numChannels);
+          bitPos = numChannels * 10;
+        }
+
+        dataLength = ((bitPos + 7) / 8) + 1; // +1 is for the flags byte
         
         //write flags
-        uint8_t flagsIdx = 5 + dataLength - 1;
-        buffer[flagsIdx]  = (isFailsafeData & 0x01) << 4;
-        buffer[flagsIdx] |= (isRequestingTelemetry & 0x01) << 3;
-        buffer[flagsIdx] |= Sys.rfPower & 0x07;
+        uint8_t flagsIdx = dataLength - 1;
+        msg.data[flagsIdx]  = (isFailsafeData & 0x01) << 4;
+        msg.data[flagsIdx] |= (isRequestingTelemetry & 0x01) << 3;
+        msg.data[flagsIdx] |= Sys.rfPower & 0x07;
+        msg.data[flagsIdx] |= (Sys.rfFrameRate & 0x03) << 5;
+        msg.data[flagsIdx] |= (isMixed & 0x01) << 7;
       }
       break;
   }
 
-  // Add other fields and send
-  if(messageType != MESSAGE_TYPE_NONE || thisLoopNum == 1)
+  // Encode and send
+  if(messageType != MESSAGE_TYPE_NONE || rcFrameCount == 1)
   {
-    //Preamble
-    buffer[0] = 0xAA;
-    buffer[1] = 0xAA;
-    buffer[2] = 0xAA;
-  
-    //Message type
-    buffer[3] = messageType;
+    msg.type = messageType;
+    msg.length = dataLength;
+    uint8_t frame[UART_MAX_FRAME_SIZE];
+    Serial1.write(frame, uartEncodeMessage(&msg, frame));
+    if(messageType == MESSAGE_TYPE_RC_DATA)
+      profRecordRcAge(micros() - inputsSampleTime);
+  }
 
-    //Data length
-    buffer[4] = dataLength;
+  ///------------- GET FROM SECONDARY MCU -------------
 
-    //Data
-    //Already set.
-  
-    //CRC
-    buffer[5 + dataLength] = crc8(buffer, 5 + dataLength);
+  //Every message is taken once, a frame split over two calls is completed on the next one
+  static uart_parser_t parser;
+  while(!hasMcuMessage && Serial1.available() > 0)
+  {
+    if(uartParseByte(&parser, Serial1.read()))
+    {
+      memcpy(&mcuMessage, &parser.msg, sizeof(mcuMessage));
+      hasMcuMessage = true;
+    }
+  }
+}
 
-    //Padding bytes
-    //Already set.
+//--------------------------------------------------------------------------------------------------
 
-    //Send
-    Serial1.write(buffer, sizeof(buffer));
-  }
+//Takes the message parsed by the RC task, if any, making room for the next
+bool takeSecondaryMcuMessage(uart_message_t *msg)
+{
+  if(!hasMcuMessage)
+    return false;
+  uint8_t oldSREG = SREG;
+  cli();
+  memcpy(msg, &mcuMessage, sizeof(mcuMessage));
+  hasMcuMessage = false;
+  SREG = oldSREG;
+  return true;
+}
 
-  ///------------- GET FROM SECONDARY MCU -------------
+//==================================================================================================
 
-  memset(buffer, 0, sizeof(buffer));
+uint8_t getRCChannelResolution(uint8_t chIdx, bool isMixed)
+{
+  if(isMixed && Model.Channel[chIdx].resolution == CHANNEL_RESOLUTION_SWITCH)
+    return RC_CHANNEL_SWITCH;
+  return RC_CHANNEL_FULL;
+}
 
-  if(Serial1.available() < UART_FIXED_PACKET_SIZE)
-    return;
+//--------------------------------------------------------------------------------------------------
 
-  uint8_t cntr = 0;
-  while(Serial1.available() > 0)
+//Returns how many of the first numChannels fit in maxBits, numBits being the bits they take
+uint8_t fitRCChannels(uint8_t numChannels, uint16_t maxBits, bool isMixed, uint16_t *numBits)
+{
+  *numBits = 0;
+  uint8_t chIdx = 0;
+  while(chIdx < numChannels)
   {
-    if(cntr < sizeof(buffer)) 
-    {
-      buffer[cntr] = Serial1.read();
-      cntr++;
-    }
-    else //Discard any extra data
-      Serial1.read();
+    uint8_t bits = getRCChannelBits(getRCChannelResolution(chIdx, isMixed), isMixed);
+    if(*numBits + bits > maxBits)
+      break;
+    *numBits += bits;
+    chIdx++;
   }
+  return chIdx;
+}
 
-  //check CRC and extract data
-  dataLength = buffer[4];
-  uint8_t receivedCRC = buffer[5 + dataLength];
-  uint8_t computedCRC = crc8(buffer, 5 + dataLength);
-  if(computedCRC != receivedCRC)
-    return;
+//==================================================================================================
 
-  //get message type, extract the data
-  messageType = buffer[3];
-  switch(messageType)
+void handleSecondaryMcuMessage(const uart_message_t *msg)
+{
+  switch(msg->type)
   {
     case MESSAGE_TYPE_BIND_STATUS_CODE:
       {
-        bindStatusCode = buffer[5];
+        bindStatusCode = msg->data[0];
       }
       break;
 
     case MESSAGE_TYPE_RECEIVER_CONFIG_STATUS_CODE:
       {
-        receiverConfigStatusCode = buffer[5];
+        receiverConfigStatusCode = msg->data[0];
       }
       break;
 
@@ -473,14 +696,14 @@ void doSerialCommunication()
       {
         gotOutputChConfig = true;
         for(uint8_t i = 0; i < MAX_CHANNELS_PER_RECEIVER; i++)
-          outputChConfig[i] = buffer[5 + i];
+          outputChConfig[i] = msg->data[i];
       }
       break;
 
     case MESSAGE_TYPE_TELEMETRY_RF_LINK_PACKET_RATE:
       {
-        transmitterPacketRate = buffer[5];
-        receiverPacketRate = buffer[6];
+        transmitterPacketRate = msg->data[0];
+        receiverPacketRate = msg->data[1];
         
         //Calculate the Link Quality indicator
         int16_t lqi = divRoundClosest(((int16_t) receiverPacketRate * 100), transmitterPacketRate);
@@ -504,17 +727,17 @@ void doSerialCommunication()
 
     case MESSAGE_TYPE_TELEMETRY_GENERAL:
       {
-        uint8_t numFields = dataLength / 3; //there are 3 bytes per telemetry field
+        uint8_t numFields = msg->length / 3; //there are 3 bytes per telemetry field
         for(uint8_t i = 0; i < numFields; i++)
         {
-          uint8_t buffIdx = 5 + (i * 3);
-          uint8_t sensorID = buffer[buffIdx];
+          uint8_t buffIdx = i * 3;
+          uint8_t sensorID = msg->data[buffIdx];
           //check against configured Ids and copy to telemetryReceivedValue 
           for(uint8_t idx = 0; idx < NUM_CUSTOM_TELEMETRY; idx++)
           {
             if(sensorID == Model.Telemetry[idx].identifier)
             {
-              telemetryReceivedValue[idx] = joinBytes(buffer[buffIdx + 1], buffer[buffIdx + 2]);
+              telemetryReceivedValue[idx] = joinBytes(msg->data[buffIdx + 1], msg->data[buffIdx + 2]);
               if(telemetryReceivedValue[idx] != TELEMETRY_NO_DATA)
               {
                 telemetryLastReceivedValue[idx] = telemetryReceivedValue[idx];
@@ -529,7 +752,7 @@ void doSerialCommunication()
     case MESSAGE_TYPE_TELEMETRY_GNSS:
       {
         //copy into the struct
-        memcpy(&GNSSTelemetryData, &buffer[5], sizeof(GNSSTelemetryData));
+        memcpy(&GNSSTelemetryData, &msg->data[0], sizeof(GNSSTelemetryData));
 
         gnssTelemetrylastReceivedTime = millis();
 
@@ -603,7 +826,6 @@ void doSerialCommunication()
       }
       break;
   }
-
 }
 
 //==================================================================================================
@@ -5,6 +5,12 @@ void handlePowerOff();
 void checkBattery();
 void turnOnBacklight();
 
+//RC task, see mtx.cpp
+bool isInputsOwner(); //false when called from the background while the RC task runs
+bool isInRcTask();
+void holdMixer();     //nestable, the RC task then resends the last outputs
+void releaseMixer();
+
 int16_t getFreeRam(); //for debug
 
 #endif
\ No newline at end of file
@@ -0,0 +1,343 @@
+#include "Arduino.h"
+
+#include "common.h"
+#include "profiler.h"
+
+prof_stage_stats_t profStats[PROF_STAGE_COUNT];
+prof_screen_stats_t profScreenStats[PROF_SCREEN_SLOTS];
+static uint32_t overrunCount;
+
+#define PROF_MAX_NESTING 3
+
+static uint8_t  nestingLevel = 0;
+static uint8_t  skippedLevels = 0; //stages begun too deep, whose ends pop nothing
+static uint32_t beginTime[PROF_MAX_NESTING];
+static uint32_t innerTime[PROF_MAX_NESTING]; //time taken by inner stages
+
+//Upper limits of the histogram bins in microseconds. The last bin takes the rest.
+static const uint16_t binLimits[PROF_HISTOGRAM_BINS - 1] PROGMEM = {
+  250, 500, 1000, 2000, 5000, 10000, 20000
+};
+
+static const char stageName0[] PROGMEM = "Switches";
+static const char stageName1[] PROGMEM = "Sticks";
+static const char stageName2[] PROGMEM = "Mixer";
+static const char stageName3[] PROGMEM = "UI";
+static const char stageName4[] PROGMEM = "Screen";
+static const char stageName5[] PROGMEM = "LCD";
+static const char stageName6[] PROGMEM = "EEPROM";
+static const char stageName7[] PROGMEM = "Serial";
+static const char stageName8[] PROGMEM = "Telemetry";
+static const char stageName9[] PROGMEM = "Frame";
+static const char stageName10[] PROGMEM = "RC age";
+
+static const char* const stageNames[PROF_STAGE_COUNT] PROGMEM = {
+  stageName0, stageName1, stageName2, stageName3, stageName4, stageName5, 
+  stageName6, stageName7, stageName8, stageName9, stageName10
+};
+
+//--------------------------------------------------------------------------------------------------
+
+static void record(uint8_t stage, uint32_t elapsed)
+{
+  prof_stage_stats_t *st = &profStats[stage];
+  uint16_t t = (elapsed > 0xFFFF) ? 0xFFFF : elapsed;
+  
+  if(st->count == 0 || t < st->minTime)
+    st->minTime = t;
+  if(t > st->maxTime)
+    st->maxTime = t;
+  
+  //halve the sums instead of overflowing, so the average follows recent frames
+  if(st->sumTime >= 0x80000000UL)
+  {
+    st->sumTime /= 2;
+    st->count /= 2;
+  }
+  st->sumTime += t;
+  st->count++;
+  
+  uint8_t bin = 0;
+  while(bin < PROF_HISTOGRAM_BINS - 1 && t >= pgm_read_word(&binLimits[bin]))
+    bin++;
+  if(st->histogram[bin] == 0xFFFF)
+  {
+    for(uint8_t i = 0; i < PROF_HISTOGRAM_BINS; i++)
+      st->histogram[i] /= 2;
+  }
+  st->histogram[bin]++;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+static void recordScreen(uint8_t screen, uint32_t elapsed)
+{
+  uint16_t t = (elapsed > 0xFFFF) ? 0xFFFF : elapsed;
+  
+  //the slot of the screen, else a free one, else the one with the lowest maximum if this is slower
+  prof_screen_stats_t *st = NULL;
+  prof_screen_stats_t *lowest = &profScreenStats[0];
+  for(uint8_t i = 0; i < PROF_SCREEN_SLOTS; i++)
+  {
+    prof_screen_stats_t *slot = &profScreenStats[i];
+    if(slot->count > 0 && slot->screen == screen)
+    {
+      st = slot;
+      break;
+    }
+    if(slot->count == 0 || (lowest->count > 0 && slot->maxTime < lowest->maxTime))
+      lowest = slot;
+  }
+  if(st == NULL)
+  {
+    if(lowest->count > 0 && t <= lowest->maxTime)
+      return;
+    st = lowest;
+    memset(st, 0, sizeof(prof_screen_stats_t));
+    st->screen = screen;
+  }
+  
+  if(st->count == 0 || t < st->minTime)
+    st->minTime = t;
+  if(t > st->maxTime)
+    st->maxTime = t;
+  if(st->sumTime >= 0x80000000UL)
+  {
+    st->sumTime /= 2;
+    st->count /= 2;
+  }
+  st->sumTime += t;
+  st->count++;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void profBegin(uint8_t stage)
+{
+  (void) stage;
+  uint8_t oldSREG = SREG;
+  cli(); //the RC task may come in between
+  if(nestingLevel < PROF_MAX_NESTING)
+  {
+    beginTime[nestingLevel] = micros();
+    innerTime[nestingLevel] = 0;
+    nestingLevel++;
+  }
+  else
+    skippedLevels++;
+  SREG = oldSREG;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//Gets the time of the stage, without its inner stages. Returns false if it was not timed.
+static bool endStage(uint8_t stage, uint32_t *ownTime)
+{
+  bool isTimed = false;
+  uint8_t oldSREG = SREG;
+  cli(); //the RC task may come in between
+  if(skippedLevels > 0) //stages are ended in reverse order, so this is one begun too deep
+    skippedLevels--;
+  else if(nestingLevel > 0)
+  {
+    nestingLevel--;
+    uint32_t elapsed = micros() - beginTime[nestingLevel];
+    if(nestingLevel > 0)
+      innerTime[nestingLevel - 1] += elapsed;
+    *ownTime = elapsed - innerTime[nestingLevel];
+    record(stage, *ownTime);
+    isTimed = true;
+  }
+  SREG = oldSREG;
+  return isTimed;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void profEnd(uint8_t stage)
+{
+  if(stage >= PROF_STAGE_COUNT)
+    return;
+  uint32_t ownTime;
+  endStage(stage, &ownTime);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void profEndScreen(uint8_t screen)
+{
+  uint32_t ownTime;
+  if(endStage(PROF_STAGE_SCREEN, &ownTime))
+    recordScreen(screen, ownTime);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void profRecordFrame(uint32_t frameTime)
+{
+  record(PROF_STAGE_FRAME, frameTime);
+  if(frameTime > (fixedLoopTime * 1000UL))
+    profCountOverrun();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void profRecordRcAge(uint32_t age)
+{
+  record(PROF_STAGE_RC_AGE, age);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void profCountOverrun()
+{
+  uint8_t oldSREG = SREG;
+  cli(); //counted both in the background and in the RC task
+  overrunCount++;
+  SREG = oldSREG;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint32_t profGetOverrunCount()
+{
+  uint8_t oldSREG = SREG;
+  cli();
+  uint32_t count = overrunCount;
+  SREG = oldSREG;
+  return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void profReset()
+{
+  uint8_t oldSREG = SREG;
+  cli(); //the RC task stages record into the stats too
+  memset(profStats, 0, sizeof(profStats));
+  memset(profScreenStats, 0, sizeof(profScreenStats));
+  overrunCount = 0;
+  SREG = oldSREG;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void profGetStageStats(uint8_t stage, prof_stage_stats_t *st)
+{
+  uint8_t oldSREG = SREG;
+  cli();
+  *st = profStats[stage];
+  SREG = oldSREG;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void profGetScreenStats(uint8_t slot, prof_screen_stats_t *st)
+{
+  uint8_t oldSREG = SREG;
+  cli();
+  *st = profScreenStats[slot];
+  SREG = oldSREG;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint16_t profGetAverage(uint8_t stage)
+{
+  if(stage >= PROF_STAGE_COUNT)
+    return 0;
+  prof_stage_stats_t st;
+  profGetStageStats(stage, &st);
+  if(st.count == 0)
+    return 0;
+  return st.sumTime / st.count;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint16_t profGetScreenAverage(uint8_t slot)
+{
+  if(slot >= PROF_SCREEN_SLOTS)
+    return 0;
+  prof_screen_stats_t st;
+  profGetScreenStats(slot, &st);
+  if(st.count == 0)
+    return 0;
+  return st.sumTime / st.count;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+const char* profGetStageName(uint8_t stage)
+{
+  if(stage >= PROF_STAGE_COUNT)
+    return NULL;
+  return (const char*) pgm_read_ptr(&stageNames[stage]);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint16_t profGetHistogramBinLimit(uint8_t bin)
+{
+  if(bin >= PROF_HISTOGRAM_BINS - 1)
+    return 0;
+  return pgm_read_word(&binLimits[bin]);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void profDumpToSerial()
+{
+  //CSV, times in microseconds
+  Serial.print(F("stage,count,min,avg,max"));
+  for(uint8_t i = 0; i < PROF_HISTOGRAM_BINS - 1; i++)
+  {
+    Serial.print(F(",<"));
+    Serial.print(profGetHistogramBinLimit(i));
+  }
+  Serial.print(F(",>="));
+  Serial.println(profGetHistogramBinLimit(PROF_HISTOGRAM_BINS - 2));
+  
+  for(uint8_t stage = 0; stage < PROF_STAGE_COUNT; stage++)
+  {
+    prof_stage_stats_t st;
+    profGetStageStats(stage, &st);
+    Serial.print((const __FlashStringHelper*) profGetStageName(stage));
+    Serial.print(F(","));
+    Serial.print(st.count);
+    Serial.print(F(","));
+    Serial.print(st.minTime);
+    Serial.print(F(","));
+    Serial.print(st.count > 0 ? st.sumTime / st.count : 0);
+    Serial.print(F(","));
+    Serial.print(st.maxTime);
+    for(uint8_t i = 0; i < PROF_HISTOGRAM_BINS; i++)
+    {
+      Serial.print(F(","));
+      Serial.print(st.histogram[i]);
+    }
+    Serial.println();
+  }
+  
+  //the slowest screens, by their main UI state
+  for(uint8_t slot = 0; slot < PROF_SCREEN_SLOTS; slot++)
+  {
+    prof_screen_stats_t st;
+    profGetScreenStats(slot, &st);
+    if(st.count == 0)
+      continue;
+    Serial.print(F("screen "));
+    Serial.print(st.screen);
+    Serial.print(F(","));
+    Serial.print(st.count);
+    Serial.print(F(","));
+    Serial.print(st.minTime);
+    Serial.print(F(","));
+    Serial.print(st.sumTime / st.count);
+    Serial.print(F(","));
+    Serial.println(st.maxTime);
+  }
+  
+  Serial.print(F("overruns,"));
+  Serial.println(profGetOverrunCount());
+}
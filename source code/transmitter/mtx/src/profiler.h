@@ -0,0 +1,69 @@
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+//Per-stage timing of the main loop, shown in the debug statistics screen.
+
+enum prof_stage_e {
+  PROF_STAGE_SWITCHES,    //readSwitchesAndButtons
+  PROF_STAGE_STICKS,      //readSticks
+  PROF_STAGE_MIXER,       //computeChannelOutputs
+  PROF_STAGE_UI,          //handleMainUI, without the screen handler and the LCD flush
+  PROF_STAGE_SCREEN,      //the handler of the current screen, also timed per screen
+  PROF_STAGE_LCD_FLUSH,   //display.display()
+  PROF_STAGE_EEPROM,      //lazy writes of model and system data
+  PROF_STAGE_SERIAL,      //doSerialCommunication
+  PROF_STAGE_TELEMETRY,   //handleTelemetry
+  PROF_STAGE_FRAME,       //the whole background loop, without the wait for the next frame
+  PROF_STAGE_RC_AGE,      //not a stage, the time from reading the inputs to sending the RC data
+  
+  PROF_STAGE_COUNT
+};
+
+#define PROF_HISTOGRAM_BINS 8
+
+typedef struct {
+  uint16_t minTime;  //in microseconds
+  uint16_t maxTime;
+  uint32_t sumTime;
+  uint32_t count;
+  uint16_t histogram[PROF_HISTOGRAM_BINS];
+} prof_stage_stats_t;
+
+//The screens whose handlers took the longest, by maximum time. A slot is free when count is 0.
+#define PROF_SCREEN_SLOTS 4
+
+typedef struct {
+  uint8_t  screen;
+  uint16_t minTime;  //in microseconds
+  uint16_t maxTime;
+  uint32_t sumTime;
+  uint32_t count;
+} prof_screen_stats_t;
+
+extern prof_stage_stats_t profStats[PROF_STAGE_COUNT];
+extern prof_screen_stats_t profScreenStats[PROF_SCREEN_SLOTS];
+
+//Stages can be nested. The time spent in an inner stage is not counted in the outer one.
+//The RC task stages nest into the background ones they interrupt. Stages nested deeper than 
+//the profiler keeps are not recorded, their time going to the outer stage.
+void profBegin(uint8_t stage);
+void profEnd(uint8_t stage);
+void profEndScreen(uint8_t screen); //ends PROF_STAGE_SCREEN, also recording it for the screen
+void profRecordFrame(uint32_t frameTime);
+void profRecordRcAge(uint32_t age);
+void profCountOverrun(); //also from the RC task
+
+//frames that took longer than fixedLoopTime, RC task included
+uint32_t profGetOverrunCount();
+
+void profReset();
+//Copies of the stats, taken with interrupts off as the RC task may be recording into them
+void profGetStageStats(uint8_t stage, prof_stage_stats_t *st);
+void profGetScreenStats(uint8_t slot, prof_screen_stats_t *st);
+uint16_t profGetAverage(uint8_t stage);
+uint16_t profGetScreenAverage(uint8_t slot);
+const char* profGetStageName(uint8_t stage); //string in PROGMEM
+uint16_t profGetHistogramBinLimit(uint8_t bin); //upper limit of a bin, 0 for the last bin
+void profDumpToSerial();
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef _RC_PACKING_H_
+#define _RC_PACKING_H_
+
+//RC channel values in the RC packets, see protocol_over_rf.txt. A value is 0 to 1000, with 1022 
+//and 1023 for the failsafe Hold and No pulse. Values are packed one after the other as a stream 
+//of bits, most significant bit first. With mixed resolution, each is preceded by a bit that is
+//set for a switch channel.
+
+#define RC_MAX_CHANNELS 20
+
+enum {
+  RC_CHANNEL_FULL = 0,   //10 bits
+  RC_CHANNEL_SWITCH = 1, //2 bits, 0, 500 or 1000
+};
+
+//At most 16 bits at a time. buff must be zeroed before writing.
+void writeBits(uint8_t *buff, uint16_t *bitPos, uint16_t val, uint8_t numBits);
+uint16_t readBits(const uint8_t *buff, uint16_t *bitPos, uint8_t numBits);
+
+//Full resolution only, 4 channels to every 5 bytes. Pack writes all (numChannels*10 + 7)/8 
+//bytes, zero padded, so buff need not be zeroed.
+void packFullRCChannels(uint8_t *buff, const uint16_t *values, uint8_t numChannels);
+void unpackFullRCChannels(const uint8_t *buff, uint16_t *values, uint8_t numChannels);
+
+uint8_t getRCChannelBits(uint8_t resolution, bool isMixed);
+void packRCChannel(uint8_t *buff, uint16_t *bitPos, uint16_t val, uint8_t resolution, bool isMixed);
+
+//Unpacks the values from the length bytes of buff, returns the number of channels
+uint8_t unpackRCChannels(const uint8_t *buff, uint8_t length, uint16_t *values, bool isMixed);
+
+#endif
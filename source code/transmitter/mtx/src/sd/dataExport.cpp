@@ -561,6 +561,7 @@ void exportModelData(File& file)
       writeKeyValue_Char(file, 1, key_Failsafe, findStringInIdStr(enum_ChannelFailsafe, ch->failsafe));
     writeKeyValue_S32(file, 1, key_EndpointL, ch->endpointL);
     writeKeyValue_S32(file, 1, key_EndpointR, ch->endpointR);
+    writeKeyValue_Char(file, 1, key_Resolution, findStringInIdStr(enum_ChannelResolution, ch->resolution));
   }
 
   file.println(F("# ------ Widgets ------"));
@@ -727,6 +728,7 @@ void exportSystemData(File& file)
   writeKeyValue_Char(file, 0, key_RF, NULL);
   // writeKeyValue_bool(file, 1, key_Enabled, Sys.rfEnabled);
   writeKeyValue_Char(file, 1, key_Power, findStringInIdStr(enum_RFpower, Sys.rfPower));
+  writeKeyValue_Char(file, 1, key_FrameRate, findStringInIdStr(enum_RFframeRate, Sys.rfFrameRate));
 
   file.println(F("# ------ Sound ------"));
 
@@ -844,6 +844,8 @@ void extractConfig_Channels()
       ch->endpointL = atoi_with_prefix(valueBuff);
     else if(MATCH_P(keyBuff[1], key_EndpointR))
       ch->endpointR = atoi_with_prefix(valueBuff);
+    else if(MATCH_P(keyBuff[1], key_Resolution))
+      findIdInIdStr(enum_ChannelResolution, valueBuff, ch->resolution);
     else
       hasEncounteredInvalidParam = true;
   }
@@ -1026,6 +1028,8 @@ void extractConfig_RF()
 {
   if(MATCH_P(keyBuff[1], key_Power))
     findIdInIdStr(enum_RFpower, valueBuff, Sys.rfPower);
+  else if(MATCH_P(keyBuff[1], key_FrameRate))
+    findIdInIdStr(enum_RFframeRate, valueBuff, Sys.rfFrameRate);
   else
     hasEncounteredInvalidParam = true;
 }
@@ -17,6 +17,13 @@ const id_string_t enum_RFpower[] PROGMEM = {
   {0, ""} //indicates end so we omit passing sizeof(enum_RFpower)/sizeof(enum_RFpower[0])
 };
 
+const id_string_t enum_RFframeRate[] PROGMEM = {
+  {RF_FRAME_RATE_50HZ, "50 Hz"},
+  {RF_FRAME_RATE_100HZ, "100 Hz"},
+  {RF_FRAME_RATE_150HZ, "150 Hz"},
+  {0, ""}
+};
+
 const id_string_t enum_BacklightWakeup[] PROGMEM = {
   {BACKLIGHT_WAKEUP_KEYS, "Keys"},
   {BACKLIGHT_WAKEUP_ACTIVITY, "Activity"},
@@ -239,6 +246,12 @@ const id_string_t enum_ChannelCurve[] PROGMEM = {
   {0, ""}
 };
 
+const id_string_t enum_ChannelResolution[] PROGMEM = {
+  {CHANNEL_RESOLUTION_FULL, "Full"},
+  {CHANNEL_RESOLUTION_SWITCH, "Switch"},
+  {0, ""}
+};
+
 const id_string_t enum_TelemetryType[] PROGMEM = {
   {TELEMETRY_TYPE_GENERAL, "General"},
   {TELEMETRY_TYPE_GNSS, "GNSS"},
@@ -443,6 +456,7 @@ const char key_OverrideVal[] PROGMEM = "OverrideVal";
 const char key_Failsafe[] PROGMEM = "Failsafe";
 const char key_EndpointL[] PROGMEM = "EndpointL";
 const char key_EndpointR[] PROGMEM = "EndpointR";
+const char key_Resolution[] PROGMEM = "Resolution";
 
 const char key_Telemetry[] PROGMEM = "Telemetry";
 // const char key_Type[] PROGMEM = "Type";
@@ -509,6 +523,7 @@ const char key_LockOnInactivity[] PROGMEM = "LockOnInactivity";
 const char key_RF[] PROGMEM = "RF";
 // const char key_Enabled[] PROGMEM = "Enabled";
 const char key_Power[] PROGMEM = "Power";
+const char key_FrameRate[] PROGMEM = "FrameRate";
 
 const char key_Sound[] PROGMEM = "Sound";
 // const char key_Enabled[] PROGMEM = "Enabled";
@@ -26,6 +26,7 @@ void getControlSwitchName_Clean(char* buff, uint8_t idx, uint8_t lenBuff);
 
 //system related
 extern const id_string_t enum_RFpower[] PROGMEM;
+extern const id_string_t enum_RFframeRate[] PROGMEM;
 extern const id_string_t enum_BacklightWakeup[] PROGMEM;
 extern const id_string_t enum_BacklightTimeout[] PROGMEM;
 extern const id_string_t enum_TrimToneFreqMode[] PROGMEM;
@@ -54,6 +55,7 @@ extern const id_string_t enum_LogicalSwitch_Func[] PROGMEM;
 extern const id_string_t enum_DirectionOfChange[] PROGMEM;
 extern const id_string_t enum_ChannelFailsafe[] PROGMEM;
 extern const id_string_t enum_ChannelCurve[] PROGMEM;
+extern const id_string_t enum_ChannelResolution[] PROGMEM;
 extern const id_string_t enum_TelemetryType[] PROGMEM;
 extern const id_string_t enum_TelemetryAlarmCondition[] PROGMEM;
 extern const id_string_t enum_WidgetType[] PROGMEM;
@@ -195,6 +197,7 @@ extern const char key_OverrideVal[] PROGMEM;
 extern const char key_Failsafe[] PROGMEM;
 extern const char key_EndpointL[] PROGMEM;
 extern const char key_EndpointR[] PROGMEM;
+extern const char key_Resolution[] PROGMEM;
 
 extern const char key_Telemetry[] PROGMEM;
 // extern const char key_Type[] PROGMEM;
@@ -264,6 +267,7 @@ extern const char key_LockOnInactivity[] PROGMEM;
 extern const char key_RF[] PROGMEM;
 // extern const char key_Enabled[] PROGMEM;
 extern const char key_Power[] PROGMEM;
+extern const char key_FrameRate[] PROGMEM;
 
 extern const char key_Sound[] PROGMEM;
 // extern const char key_Enabled[] PROGMEM;
@@ -0,0 +1,85 @@
+#include "Arduino.h"
+
+#include "crc.h"
+#include "uartMessage.h"
+
+//A frame is the message (type, length, data, CRC) encoded with COBS so that it has no zero
+//bytes, followed by a zero byte. Each block starts with a code byte, one more than the number
+//of data bytes that follow it, and ends with a zero that is not sent. The last block has no
+//such zero. A whole message being shorter than 254 bytes, blocks are never longer than that.
+
+//--------------------------------------------------------------------------------------------------
+
+uint8_t uartEncodeMessage(uart_message_t *msg, uint8_t *frame)
+{
+  if(msg->length > UART_MAX_DATA_LENGTH)
+    return 0;
+
+  //the struct is all bytes, laid out as sent
+  const uint8_t *src = (const uint8_t *) msg;
+  uint8_t srcLen = msg->length + 3;
+  msg->data[msg->length] = crc8(src, srcLen - 1);
+
+  uint8_t codeIdx = 0;
+  uint8_t code = 1;
+  uint8_t len = 1;
+  for(uint8_t i = 0; i < srcLen; i++)
+  {
+    if(src[i] == 0)
+    {
+      frame[codeIdx] = code;
+      codeIdx = len++;
+      code = 1;
+    }
+    else
+    {
+      frame[len++] = src[i];
+      code++;
+    }
+  }
+  frame[codeIdx] = code;
+  frame[len++] = 0x00;
+  return len;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+static void addByte(uart_parser_t *parser, uint8_t c)
+{
+  if(parser->count < sizeof(uart_message_t))
+    ((uint8_t *) &parser->msg)[parser->count++] = c;
+  else
+    parser->isOverrun = true;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool uartParseByte(uart_parser_t *parser, uint8_t c)
+{
+  if(c == 0x00) //end of frame
+  {
+    uart_message_t *msg = &parser->msg;
+    bool isValid = !parser->isOverrun && parser->blockLeft == 0 && parser->count >= 3
+                   && msg->length == parser->count - 3
+                   && msg->data[msg->length] == crc8((const uint8_t *) msg, parser->count - 1);
+    parser->count = 0;
+    parser->blockLeft = 0;
+    parser->hasZero = false;
+    parser->isOverrun = false;
+    return isValid;
+  }
+
+  if(parser->blockLeft == 0) //code byte
+  {
+    if(parser->hasZero)
+      addByte(parser, 0);
+    parser->blockLeft = c - 1;
+    parser->hasZero = (c != 0xFF);
+  }
+  else
+  {
+    addByte(parser, c);
+    parser->blockLeft--;
+  }
+  return false;
+}
@@ -0,0 +1,30 @@
+#ifndef _UART_MESSAGE_H_
+#define _UART_MESSAGE_H_
+
+//Messages over the UART between the main and the secondary transmitter MCUs.
+//See protocol_over_uart.txt
+
+#define UART_MAX_DATA_LENGTH  42
+#define UART_MAX_FRAME_SIZE   (UART_MAX_DATA_LENGTH + 5) //encoded, with the delimiter
+
+typedef struct {
+  uint8_t type;
+  uint8_t length; //of the data
+  uint8_t data[UART_MAX_DATA_LENGTH + 1]; //the CRC follows the data
+} uart_message_t;
+
+typedef struct {
+  uart_message_t msg;
+  uint8_t count;      //bytes decoded into msg
+  uint8_t blockLeft;  //bytes left in the current COBS block, 0 when a code byte is next
+  bool    hasZero;    //the current block ends with a zero, unless it is the last one
+  bool    isOverrun;  //too long, dropped at the delimiter
+} uart_parser_t;
+
+//Sets the CRC and encodes the message into frame, returns the number of bytes to send
+uint8_t uartEncodeMessage(uart_message_t *msg, uint8_t *frame);
+
+//Takes the received bytes one at a time. Returns true when parser->msg holds a new message.
+bool uartParseByte(uart_parser_t *parser, uint8_t c);
+
+#endif
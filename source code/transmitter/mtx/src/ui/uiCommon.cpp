@@ -6,7 +6,7 @@
 #include "../mathHelpers.h"
 #include "../inputs.h"
 #include "../mixer.h"
-#include "../sd/sdstore.h"
+#include "../sd/sdStore.h"
 #include "uiCommon.h"
 
 bool isEditMode = false;
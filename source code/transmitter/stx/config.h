@@ -25,5 +25,12 @@
 #define ISM_433MHZ
 // #define ISM_915MHZ
 
+//--- RC data at the 50 Hz frame rate. A keyframe with all the channels every RC_KEYFRAME_INTERVAL 
+//packets, and in between only the channels that differ from it. Comment out to always send all.
+#define RC_KEYFRAME_INTERVAL  8
+
+//--- Baud rate of the UART to mtx, the same as UART_BAUD_RATE in the mtx config.h
+#define UART_BAUD_RATE   500000
+
 
 #endif
@@ -10,10 +10,12 @@ uint8_t  transmitPayloadLength;
 uint8_t  receivePayloadLength;
 
 uint8_t  rfPower;
+uint8_t  rfFrameRate = 0;
 bool     isRequestingBind = false;
 uint8_t  bindStatusCode;  
 bool     isMainReceiver = true;
 bool     hasPendingRCData = false;
+uint32_t rcDataDropCount = 0;
 bool     hasReceivedTelemetry = false;
 uint8_t  transmitterPacketRate;
 uint8_t  receiverPacketRate;
@@ -14,11 +14,13 @@ extern uint8_t transmitPayloadLength;
 extern uint8_t receivePayloadLength;
  
 extern uint8_t rfPower;
+extern uint8_t rfFrameRate; //0 = 50 Hz, 1 = 100 Hz, 2 = 150 Hz. Sets the LoRa settings, see rfComm.cpp
 
 extern bool     isRequestingBind;
 extern uint8_t  bindStatusCode;  //1 on success, 2 on fail
  
 extern bool     hasPendingRCData;
+extern uint32_t rcDataDropCount; //RC data from mtx replaced by newer data before it was sent
 
 extern bool     hasReceivedTelemetry;
 extern uint32_t generalTelemetryLastReceiveTime;
@@ -7,6 +7,7 @@
 #include "common.h"
 #include "crc.h"
 #include "eestore.h"
+#include "rcPacking.h"
 #include "rfComm.h"
 
 //--------------- Freq allocation --------------------
@@ -42,6 +43,50 @@
   #error Number of hop channels cannot exceed number of available frequencies
 #endif 
 
+//--------------- Frame rates ------------------------
+/*
+  LoRa settings for each frame rate, chosen so that the RC packet fits in the frame.
+  All use 500 kHz bandwidth and coding rate 4/5. Air times as per the SX1276 datasheet.
+
+  Frame rate   SF   Header     Preamble   RC packet              Air time
+  50 Hz        7    explicit   8          up to 30 bytes (20ch)  16.7 ms
+  100 Hz       6    implicit   6          18 bytes (10ch)         6.2 ms
+  150 Hz       6    implicit   6          15 bytes (8ch)          5.5 ms
+
+  SF6 requires an implicit header, so at the higher frame rates every packet on the hop channels 
+  has a fixed length. Packets from the transmitter are padded to the length of the RC packet, 
+  those from the receiver to that of the GNSS telemetry packet (6.8 ms). 
+  Binding is always done with the 50 Hz settings. Keep in sync with the receiver.
+
+  The frames follow a fixed schedule, a cycle of cycleFrames frames, one per RC data from mtx. 
+  While mtx wants telemetry, the last downlinkFrames of each cycle are a downlink slot, in which 
+  the receiver sends telemetry and the RC data from mtx is not sent. The RC packet just before 
+  the slot is marked for the receiver to reply. The slot starts when that packet ends and lasts 
+  downlinkFrames frame periods, RC data held until then unless the reply came. The defaults give 
+  a slot every 640 ms at all frame rates. A shorter cycle gives more telemetry for fewer RC packets.
+*/
+
+typedef struct {
+  uint16_t framePeriod;         //in microseconds
+  uint8_t spreadingFactor;
+  uint8_t preambleLength;
+  uint8_t uplinkPacketLength;   //transmitter to receiver, 0 for explicit header
+  uint8_t downlinkPacketLength; //receiver to transmitter, 0 for explicit header
+  uint8_t cycleFrames;          //frames in the schedule
+  uint8_t downlinkFrames;       //frames of the downlink slot at the end of it
+} frame_rate_profile_t;
+
+#define NUM_FRAME_RATES 3
+frame_rate_profile_t frameRateProfile[NUM_FRAME_RATES] = {
+  {20000, 7, 8, 0,  0,  32, 1}, //50 Hz
+  {10000, 6, 6, 18, 21, 64, 1}, //100 Hz
+  {6667,  6, 6, 15, 21, 96, 2}  //150 Hz
+};
+
+uint8_t activeFrameRate = 0xFF;
+uint8_t fixedTxPacketLength = 0; //0 if explicit header
+uint8_t fixedRxPacketLength = 0; //0 if explicit header
+
 //------------------------------------------------
 
 #if NUM_HOP_CHANNELS > (MAX_PAYLOAD_SIZE - 2)
@@ -62,6 +107,8 @@ enum {
   PACKET_RC_DATA = 5,
   PACKET_TELEMETRY_GENERAL = 6,
   PACKET_TELEMETRY_GNSS = 7,
+  PACKET_RC_KEYFRAME = 8,
+  PACKET_RC_DELTA = 9,
 
   PACKET_INVALID = 0xFF
 };
@@ -70,16 +117,27 @@ bool     radioInitialised = false;
 uint32_t totalPacketsSent = 0;
 
 bool isListeningForTelemetry = false;
+uint32_t downlinkSlotStartTime; //in microseconds
+
+#ifdef RC_KEYFRAME_INTERVAL
+uint16_t keyframeChannels[RC_MAX_CHANNELS]; //the channel values of the last keyframe
+uint8_t keyframeNumChannels;
+uint8_t keyframeNumber = 0;
+uint8_t packetsSinceKeyframe = RC_KEYFRAME_INTERVAL; //a keyframe first
+#endif
 
 //function declarations
 void setRfPower(uint8_t dBm);
+void setFrameRate(uint8_t idx);
 void hop();
 void bind();
 void transmitRCdata();
 void transmitReceiverConfig();
 void getReceiverConfig();
 void getTelemetry();
+bool isDownlinkSlotOpen();
 void buildPacket(uint8_t sourceID, uint8_t destinationID, uint8_t dataIdentifier, uint8_t *dataBuffer, uint8_t dataLength);
+void buildRCPacket();
 void readReceivedPacket();
 uint8_t checkReceivedPacket(uint8_t sourceID, uint8_t destinationID);
 
@@ -91,9 +149,9 @@ void initialiseRfModule()
   LoRa.setPins(PIN_LORA_SS, PIN_LORA_RESET); 
   if(LoRa.begin(freqList[0]))
   {
-    LoRa.setSpreadingFactor(7); 
     LoRa.setCodingRate4(5);
     LoRa.setSignalBandwidth(500E3);
+    setFrameRate(0);
     delay(20);
     //start in low power level
     LoRa.sleep();
@@ -125,7 +183,7 @@ void doRfCommunication()
   {
     transmitReceiverConfig();
   }
-  else if(hasPendingRCData)
+  else if(hasPendingRCData && !isDownlinkSlotOpen())
   {
     if(isListeningForTelemetry)
     {
@@ -136,11 +194,12 @@ void doRfCommunication()
       hop();
     }
     
-    //set RF power level
+    //set RF power level and frame rate
     if(!LoRa.isTransmitting())
     {
       static uint8_t power_dBm[3] = {3, 10, 17}; //2 mW, 10 mW, 50 mW
       setRfPower(power_dBm[rfPower]);
+      setFrameRate(rfFrameRate);
     }
 
     //transmit
@@ -197,6 +256,40 @@ void setRfPower(uint8_t dBm)
 
 //--------------------------------------------------------------------------------------------------
 
+void setFrameRate(uint8_t idx)
+{
+  if(idx >= NUM_FRAME_RATES)
+    idx = 0;
+  if(idx == activeFrameRate)
+    return;
+  activeFrameRate = idx;
+  LoRa.idle();
+  LoRa.setSpreadingFactor(frameRateProfile[idx].spreadingFactor);
+  LoRa.setPreambleLength(frameRateProfile[idx].preambleLength);
+  fixedTxPacketLength = frameRateProfile[idx].uplinkPacketLength;
+  fixedRxPacketLength = frameRateProfile[idx].downlinkPacketLength;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint8_t getNextFrameSlot()
+{
+  static uint8_t frameIdx = 0;
+  uint8_t idx = rfFrameRate < NUM_FRAME_RATES ? rfFrameRate : 0;
+  uint8_t cycleFrames = frameRateProfile[idx].cycleFrames;
+  uint8_t firstDownlinkFrame = cycleFrames - frameRateProfile[idx].downlinkFrames;
+  frameIdx++;
+  if(frameIdx >= cycleFrames)
+    frameIdx = 0;
+  if(frameIdx >= firstDownlinkFrame)
+    return SLOT_DOWNLINK;
+  if(frameIdx == firstDownlinkFrame - 1)
+    return SLOT_UPLINK_BEFORE_DOWNLINK;
+  return SLOT_UPLINK;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 void hop()
 {
   static uint8_t idx_fhss_schema = 0; 
@@ -263,8 +356,9 @@ void bind()
       }
     }
     
-    //--- set to lowest power level
+    //--- set to lowest power level and the bind settings
     setRfPower(2); // 2 dBm
+    setFrameRate(0);
 
     //--- set to bind frequency
     LoRa.sleep();
@@ -283,12 +377,12 @@ void bind()
     {
       transmitPayloadBuffer[i] = Sys.fhss_schema[i];
     }
-    transmitPayloadBuffer[i++] = isMainReceiver & 0x01;
+    transmitPayloadBuffer[i++] = (isMainReceiver & 0x01) | ((rfFrameRate & 0x03) << 1);
     transmitPayloadBuffer[i++] = Sys.receiverID;
     transmitPayloadLength = i;
 
     buildPacket(Sys.transmitterID, 0x00, PACKET_BIND, transmitPayloadBuffer, transmitPayloadLength);
-    if(LoRa.beginPacket())
+    if(LoRa.beginPacket(fixedTxPacketLength > 0))
     {
       LoRa.write(transmitPacketBuffer, transmitPacketLength);
       LoRa.endPacket(true); //non-blocking
@@ -306,7 +400,7 @@ void bind()
       bindAckEntryTime = millis();
     }
     
-    if(LoRa.parsePacket()) //received a packet
+    if(LoRa.parsePacket(fixedRxPacketLength)) //received a packet
     {
       readReceivedPacket();
       if(checkReceivedPacket(0x00, Sys.transmitterID) == PACKET_ACK_BIND) 
@@ -357,8 +451,8 @@ void transmitRCdata()
   //START TRANSMIT
   if(!transmitInitiated) 
   {
-    buildPacket(Sys.transmitterID, Sys.receiverID, PACKET_RC_DATA, transmitPayloadBuffer, transmitPayloadLength);
-    if(LoRa.beginPacket())
+    buildRCPacket();
+    if(LoRa.beginPacket(fixedTxPacketLength > 0))
     {
       LoRa.write(transmitPacketBuffer, transmitPacketLength);
       LoRa.endPacket(true); //async
@@ -386,9 +480,11 @@ void transmitRCdata()
 
 void getTelemetry()
 {
+  if(!isListeningForTelemetry)
+    downlinkSlotStartTime = micros();
   isListeningForTelemetry = true;
 
-  if(LoRa.parsePacket()) //received a packet
+  if(LoRa.parsePacket(fixedRxPacketLength)) //received a packet
   {
     readReceivedPacket();
     hop();
@@ -412,6 +508,17 @@ void getTelemetry()
 
 //--------------------------------------------------------------------------------------------------
 
+bool isDownlinkSlotOpen()
+{
+  if(!isListeningForTelemetry || activeFrameRate >= NUM_FRAME_RATES)
+    return false;
+  uint32_t slotTime = (uint32_t) frameRateProfile[activeFrameRate].framePeriod 
+                      * frameRateProfile[activeFrameRate].downlinkFrames;
+  return micros() - downlinkSlotStartTime < slotTime;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 void getReceiverConfig()
 {
   static bool transmitInitiated = false;
@@ -427,7 +534,7 @@ void getReceiverConfig()
   if(!transmitInitiated)
   {
     buildPacket(Sys.transmitterID, Sys.receiverID, PACKET_READ_OUTPUT_CH_CONFIG, transmitPayloadBuffer, transmitPayloadLength);
-    if(LoRa.beginPacket())
+    if(LoRa.beginPacket(fixedTxPacketLength > 0))
     {
       LoRa.write(transmitPacketBuffer, transmitPacketLength);
       LoRa.endPacket(true); //async
@@ -446,7 +553,7 @@ void getReceiverConfig()
       listenEntryTime = millis();
     }
     
-    if(LoRa.parsePacket()) //received a packet
+    if(LoRa.parsePacket(fixedRxPacketLength)) //received a packet
     {
       readReceivedPacket();
       hop();
@@ -495,7 +602,7 @@ void transmitReceiverConfig()
   if(!transmitInitiated)
   {
     buildPacket(Sys.transmitterID, Sys.receiverID, PACKET_SET_OUTPUT_CH_CONFIG, transmitPayloadBuffer, transmitPayloadLength);
-    if(LoRa.beginPacket())
+    if(LoRa.beginPacket(fixedTxPacketLength > 0))
     {
       LoRa.write(transmitPacketBuffer, transmitPacketLength);
       LoRa.endPacket(true); //async
@@ -514,7 +621,7 @@ void transmitReceiverConfig()
       listenEntryTime = millis();
     }
     
-    if(LoRa.parsePacket()) //received a packet
+    if(LoRa.parsePacket(fixedRxPacketLength)) //received a packet
     {
       readReceivedPacket();
       hop();
@@ -579,6 +686,80 @@ void buildPacket(uint8_t sourceID, uint8_t destinationID, uint8_t dataIdentifier
  
   //calculate the packet length
   transmitPacketLength = 4 + payloadLength;
+  
+  //pad to the fixed length if implicit header
+  if(transmitPacketLength < fixedTxPacketLength)
+    transmitPacketLength = fixedTxPacketLength;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void buildRCPacket()
+{
+#ifdef RC_KEYFRAME_INTERVAL
+  //Failsafe data is sent whole. So is all RC data at the higher frame rates, where packets are 
+  //padded to a fixed length anyway, after which the 50 Hz settings start with a keyframe.
+  uint8_t flags = transmitPayloadBuffer[transmitPayloadLength - 1]; //RC data always has the flags
+  bool isFailsafeData = (flags >> 4) & 0x01;
+  if(fixedTxPacketLength > 0 || isFailsafeData)
+  {
+    if(fixedTxPacketLength > 0)
+      packetsSinceKeyframe = RC_KEYFRAME_INTERVAL;
+    buildPacket(Sys.transmitterID, Sys.receiverID, PACKET_RC_DATA, transmitPayloadBuffer, transmitPayloadLength);
+    return;
+  }
+
+  bool isMixed = (flags >> 7) & 0x01;
+  uint16_t values[RC_MAX_CHANNELS];
+  uint8_t numChannels = unpackRCChannels(transmitPayloadBuffer, transmitPayloadLength - 1, values, isMixed);
+  bool isKeyframe = packetsSinceKeyframe >= RC_KEYFRAME_INTERVAL || numChannels != keyframeNumChannels;
+  packetsSinceKeyframe++;
+
+  //A delta packet has a bit per channel set for those that differ from the keyframe, then their 
+  //values at full resolution, then the flags. It is only sent if shorter than a keyframe.
+  uint8_t delta[3 + MAX_PAYLOAD_SIZE]; //up to all 20 channels
+  uint8_t deltaLength = 0;
+  if(!isKeyframe)
+  {
+    uint8_t maskLength = (numChannels + 7) / 8;
+    memset(delta, 0, maskLength);
+    uint16_t changed[RC_MAX_CHANNELS];
+    uint8_t numChanged = 0;
+    for(uint8_t chIdx = 0; chIdx < numChannels; chIdx++)
+    {
+      if(values[chIdx] != keyframeChannels[chIdx])
+      {
+        delta[chIdx / 8] |= 1 << (chIdx % 8);
+        changed[numChanged++] = values[chIdx];
+      }
+    }
+    packFullRCChannels(delta + maskLength, changed, numChanged);
+    deltaLength = maskLength + ((numChanged * 10) + 7) / 8 + 1;
+    if(deltaLength >= transmitPayloadLength)
+      isKeyframe = true;
+  }
+
+  //the flags carry the number of the keyframe instead of the frame rate, which only stx uses, 
+  //and of the failsafe flag, failsafe data being sent whole
+  if(isKeyframe)
+  {
+    keyframeNumber = (keyframeNumber + 1) & 0x07;
+    keyframeNumChannels = numChannels;
+    packetsSinceKeyframe = 1;
+    memcpy(keyframeChannels, values, sizeof(keyframeChannels));
+    uint8_t payload[MAX_PAYLOAD_SIZE];
+    memcpy(payload, transmitPayloadBuffer, transmitPayloadLength);
+    payload[transmitPayloadLength - 1] = (flags & 0x8F) | (keyframeNumber << 4);
+    buildPacket(Sys.transmitterID, Sys.receiverID, PACKET_RC_KEYFRAME, payload, transmitPayloadLength);
+  }
+  else
+  {
+    delta[deltaLength - 1] = (flags & 0x0F) | (keyframeNumber << 4);
+    buildPacket(Sys.transmitterID, Sys.receiverID, PACKET_RC_DELTA, delta, deltaLength);
+  }
+#else
+  buildPacket(Sys.transmitterID, Sys.receiverID, PACKET_RC_DATA, transmitPayloadBuffer, transmitPayloadLength);
+#endif
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -6,5 +6,13 @@ void initialiseRfModule();
 void doRfCommunication();
 void stopRfModule();
 
+enum {
+  SLOT_UPLINK,
+  SLOT_UPLINK_BEFORE_DOWNLINK, //the RC packet marked for the receiver to reply
+  SLOT_DOWNLINK,
+};
+
+uint8_t getNextFrameSlot(); //advances the schedule by a frame
+
 #endif
 
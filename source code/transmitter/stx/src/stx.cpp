@@ -1,15 +1,15 @@
 #include "Arduino.h"
 
 #include "../config.h"
-#include "crc.h"
 #include "common.h"
 #include "eestore.h"
 #include "rfComm.h"
+#include "uartMessage.h"
 
 void getSerialData();
 void sendSerialData();
-
-#define UART_FIXED_PACKET_SIZE 48
+void queueMainMcuMessage(const uart_message_t *msg);
+void handleMainMcuMessage(const uart_message_t *msg);
 
 enum {
   MESSAGE_TYPE_NONE = 0x00,
@@ -29,12 +29,26 @@ enum {
   MESSAGE_TYPE_TELEMETRY_GNSS = 0x15,
 };
 
+//Messages from mtx wait here until the previous one is done with transmitPayloadBuffer.
+//The latest RC data is kept, replacing any not yet taken. Control messages are queued.
+#define CONTROL_QUEUE_SIZE 2
+
+uart_message_t rcDataLatch;
+bool hasLatchedRCData = false;
+uart_message_t controlQueue[CONTROL_QUEUE_SIZE];
+uint8_t controlQueueHead = 0;
+uint8_t controlQueueCount = 0;
+
+//Failsafe data that came in a downlink slot, sent on the next uplink frame
+uart_message_t heldFailsafeData;
+bool hasHeldFailsafeData = false;
+
 //==================================================================================================
 
 void setup()
 {
   //--- initialise serial port
-  Serial.begin(115200);  
+  Serial.begin(UART_BAUD_RATE);  
   
   //--- delay
   delay(100);
@@ -67,54 +81,94 @@ void loop()
 
 void getSerialData()
 {
-  uint8_t buffer[UART_FIXED_PACKET_SIZE];
-  memset(buffer, 0, sizeof(buffer));
-
-  if(Serial.available() < UART_FIXED_PACKET_SIZE) 
-    return;
-
-  uint8_t cntr = 0;
+  //Every message is taken once, a frame split over two calls is completed on the next one
+  static uart_parser_t parser;
   while(Serial.available() > 0)
   {
-    if(cntr < sizeof(buffer)) 
-    {
-      buffer[cntr] = Serial.read();
-      cntr++;
-    }
-    else //Discard any extra data
-      Serial.read();
+    if(uartParseByte(&parser, Serial.read()))
+      queueMainMcuMessage(&parser.msg);
   }
 
-  //exit if busy, to prevent modifications to transmitPayloadBuffer
+  //wait if busy, to prevent modifications to transmitPayloadBuffer
   if(hasPendingRCData || isRequestingBind || isRequestingOutputChConfig || isSendOutputChConfig)
     return;
 
-  //check CRC and extract data
-  uint8_t dataLength = buffer[4];
-  uint8_t receivedCRC = buffer[5 + dataLength];
-  uint8_t computedCRC = crc8(buffer, 5 + dataLength);
-  if(computedCRC != receivedCRC)
-    return;
+  //control messages first, as doRfCommunication does
+  if(controlQueueCount > 0)
+  {
+    handleMainMcuMessage(&controlQueue[controlQueueHead]);
+    controlQueueHead = (controlQueueHead + 1) % CONTROL_QUEUE_SIZE;
+    controlQueueCount--;
+  }
+  else if(hasLatchedRCData)
+  {
+    hasLatchedRCData = false;
+    handleMainMcuMessage(&rcDataLatch);
+  }
+}
 
-  //get message type, extract the data
-  uint8_t messageType = buffer[3];
-  switch(messageType)
+//==================================================================================================
+
+void queueMainMcuMessage(const uart_message_t *msg)
+{
+  if(msg->type == MESSAGE_TYPE_RC_DATA)
+  {
+    if(msg->length == 0)
+      return;
+    if(hasLatchedRCData)
+      rcDataDropCount++;
+    memcpy(&rcDataLatch, msg, sizeof(rcDataLatch));
+    hasLatchedRCData = true;
+  }
+  else if(msg->type != MESSAGE_TYPE_NONE)
+  {
+    //dropped if full, mtx sends these only on a user action
+    if(controlQueueCount == CONTROL_QUEUE_SIZE)
+      return;
+    uint8_t idx = (controlQueueHead + controlQueueCount) % CONTROL_QUEUE_SIZE;
+    memcpy(&controlQueue[idx], msg, sizeof(controlQueue[0]));
+    controlQueueCount++;
+  }
+}
+
+//==================================================================================================
+
+void handleMainMcuMessage(const uart_message_t *msg)
+{
+  uint8_t dataLength = msg->length;
+  switch(msg->type)
   {
     case MESSAGE_TYPE_RC_DATA:
       {
         hasPendingRCData = true;
         
         //read flags
-        uint8_t flagsIdx = 5 + dataLength - 1;
-        isRequestingTelemetry = ((buffer[flagsIdx] >> 3) & 0x01);
-        rfPower = buffer[flagsIdx] & 0x07;
-
-        //Skip this RC data if we were previously requesting for telemetry
-        //to allow enough time to listen. 
-        static bool wasRequestingTelemetry = false;
-        if(wasRequestingTelemetry)
+        uint8_t flagsIdx = dataLength - 1;
+        bool isTelemetryWanted = ((msg->data[flagsIdx] >> 3) & 0x01);
+        rfPower = msg->data[flagsIdx] & 0x07;
+        rfFrameRate = (msg->data[flagsIdx] >> 5) & 0x03;
+
+        //The frame schedule runs even when mtx does not want telemetry, which only makes the 
+        //downlink slots RC frames again. In a downlink slot, the RC data is not sent.
+        //Failsafe data, only sent now and then, is held for the next uplink frame.
+        uint8_t slot = getNextFrameSlot();
+        isRequestingTelemetry = isTelemetryWanted && slot == SLOT_UPLINK_BEFORE_DOWNLINK;
+        if(isTelemetryWanted && slot == SLOT_DOWNLINK)
+        {
           hasPendingRCData = false;
-        wasRequestingTelemetry = isRequestingTelemetry;
+          if((msg->data[flagsIdx] >> 4) & 0x01)
+          {
+            memcpy(&heldFailsafeData, msg, sizeof(heldFailsafeData));
+            hasHeldFailsafeData = true;
+          }
+        }
+        else if(hasHeldFailsafeData)
+        {
+          hasHeldFailsafeData = false;
+          msg = &heldFailsafeData;
+          dataLength = msg->length;
+          flagsIdx = dataLength - 1;
+        }
 
         //copy to transmitPayloadBuffer
         if(hasPendingRCData)
@@ -128,9 +182,12 @@ void getSerialData()
           }
           for(uint8_t i = 0; i < dataLength; i++)
           {
-            transmitPayloadBuffer[i] = buffer[5 + i];
+            transmitPayloadBuffer[i] = msg->data[i];
           }
           transmitPayloadLength = dataLength;
+          //on air, the telemetry bit marks the packet before a downlink slot
+          transmitPayloadBuffer[flagsIdx] &= ~(0x01 << 3);
+          transmitPayloadBuffer[flagsIdx] |= (isRequestingTelemetry & 0x01) << 3;
         }
       }
       break;
@@ -138,7 +195,8 @@ void getSerialData()
     case MESSAGE_TYPE_ENTER_BIND:
       {
         isRequestingBind = true;
-        isMainReceiver = buffer[5] & 0x01;
+        isMainReceiver = msg->data[0] & 0x01;
+        rfFrameRate = (msg->data[0] >> 1) & 0x03;
       }
       break;
     
@@ -155,7 +213,7 @@ void getSerialData()
         }
         for(uint8_t i = 0; i < dataLength; i++)
         {
-          transmitPayloadBuffer[i] = buffer[5 + i];
+          transmitPayloadBuffer[i] = msg->data[i];
         }
         transmitPayloadLength = dataLength;
       }
@@ -174,7 +232,7 @@ void getSerialData()
         }
         for(uint8_t i = 0; i < dataLength; i++)
         {
-          transmitPayloadBuffer[i] = buffer[5 + i];
+          transmitPayloadBuffer[i] = msg->data[i];
         }
         transmitPayloadLength = dataLength;
       }
@@ -187,8 +245,8 @@ void getSerialData()
 
 void sendSerialData()
 {
-  uint8_t buffer[UART_FIXED_PACKET_SIZE];
-  memset(buffer, 0, sizeof(buffer));
+  uart_message_t msg;
+  memset(&msg, 0, sizeof(msg));
 
   uint8_t messageType = MESSAGE_TYPE_NONE;
 
@@ -224,14 +282,14 @@ void sendSerialData()
   if(bindStatusCode != 0)
   {
     messageType = MESSAGE_TYPE_BIND_STATUS_CODE;
-    buffer[5] = bindStatusCode;
+    msg.data[0] = bindStatusCode;
     bindStatusCode = 0;
   }
 
   if(receiverConfigStatusCode != 0)
   {
     messageType = MESSAGE_TYPE_RECEIVER_CONFIG_STATUS_CODE;
-    buffer[5] = receiverConfigStatusCode;
+    msg.data[0] = receiverConfigStatusCode;
     receiverConfigStatusCode = 0;
   }
 
@@ -243,10 +301,9 @@ void sendSerialData()
         uint8_t dataLength = 0;
         for(uint8_t i = 0; i < receivePayloadLength; i++)
         {
-          uint8_t buffIdx = 5 + i;
-          if(buffIdx < sizeof(buffer) - 1)
+          if(i < UART_MAX_DATA_LENGTH)
           {
-            buffer[buffIdx] = receivePayloadBuffer[i];
+            msg.data[i] = receivePayloadBuffer[i];
             dataLength++;
           }
           else
@@ -256,7 +313,7 @@ void sendSerialData()
             break;
           }
         }
-        buffer[4] = dataLength;
+        msg.length = dataLength;
       }
       break;
     
@@ -265,10 +322,9 @@ void sendSerialData()
         uint8_t dataLength = 0;
         for(uint8_t i = 0; i < (receivePayloadLength - 1); i++)
         {
-          uint8_t buffIdx = 5 + i;
-          if(buffIdx < sizeof(buffer) - 1)
+          if(i < UART_MAX_DATA_LENGTH)
           {
-            buffer[buffIdx] = receivePayloadBuffer[i + 1];
+            msg.data[i] = receivePayloadBuffer[i + 1];
             dataLength++;
           }
           else
@@ -278,30 +334,30 @@ void sendSerialData()
             break;
           }
         }
-        buffer[4] = dataLength;
+        msg.length = dataLength;
       }
       break;
 
     case MESSAGE_TYPE_RECEIVER_CONFIG_STATUS_CODE:
       {
-        buffer[4] = 1; //data length
+        msg.length = 1;
         //data already handled
       }
       break;
     case MESSAGE_TYPE_BIND_STATUS_CODE: //data already handled
       {
-        buffer[4] = 1; //data length
+        msg.length = 1;
         //data already handled
       }
       break;
 
     case MESSAGE_TYPE_TELEMETRY_RF_LINK_PACKET_RATE:
       {
-        buffer[4] = 2; //data length
-        buffer[5] = transmitterPacketRate;
+        msg.length = 2;
+        msg.data[0] = transmitterPacketRate;
         if(millis() - generalTelemetryLastReceiveTime > 3000)
           receiverPacketRate = 0;
-        buffer[6] = receiverPacketRate;
+        msg.data[1] = receiverPacketRate;
       }
       break;
   }
@@ -309,24 +365,9 @@ void sendSerialData()
   if(messageType == MESSAGE_TYPE_NONE) //nothing to send, quit
     return;
 
-  //--- Add other fields and send
-
-  //Preamble
-  buffer[0] = 0xAA;
-  buffer[1] = 0xAA;
-  buffer[2] = 0xAA;
-  
-  //Message type
-  buffer[3] = messageType;
-  
-  //CRC
-  uint8_t dataLength = buffer[4];
-  buffer[5 + dataLength] = crc8(buffer, 5 + dataLength);
-
-  //Padding bytes
-  //Already set.
-
-  //Send
-  Serial.write(buffer, sizeof(buffer));
+  //--- Encode and send
+  msg.type = messageType;
+  uint8_t frame[UART_MAX_FRAME_SIZE];
+  Serial.write(frame, uartEncodeMessage(&msg, frame));
 }
 
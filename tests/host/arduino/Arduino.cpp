@@ -0,0 +1,544 @@
+#include <stdio.h>
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "Wire.h"
+#include "HostHAL.h"
+
+//==================================================================================================
+//============================ Virtual clock =======================================================
+
+uint64_t hostTimeMicros = 0;
+uint64_t hostTimeLimitMicros = 0;
+void (*hostOnTimeLimit)() = NULL;
+void (*hostOnTimeAdvance)() = NULL;
+
+//--- Timer1
+
+HostPort TCCR1A, TCCR1B, TIFR1, TIMSK1;
+volatile uint16_t TCNT1, OCR1A;
+uint8_t SREG;
+
+//Defined by the firmware with ISR(TIMER1_COMPA_vect), if it uses the timer
+extern "C" void TIMER1_COMPA_vect(void) __attribute__((weak));
+
+//At 16 MHz with the clk/8 prescaler the timer counts 2 ticks per microsecond.
+//Compare matches are handled at their exact time within the step, to the microsecond.
+static void advanceTimer1(uint64_t us)
+{
+  while(us > 0)
+  {
+    uint32_t ticksToMatch = (uint16_t)(OCR1A - TCNT1);
+    if(ticksToMatch == 0)
+      ticksToMatch = 0x10000;
+    uint64_t usToMatch = (ticksToMatch + 1) / 2;
+    if(!(TIMSK1.value & _BV(OCIE1A)) || TIMER1_COMPA_vect == NULL || usToMatch > us)
+    {
+      TCNT1 += us * 2;
+      hostTimeMicros += us;
+      return;
+    }
+    hostTimeMicros += usToMatch;
+    us -= usToMatch;
+    TCNT1 = OCR1A;
+    TIMER1_COMPA_vect();
+    TCNT1 += usToMatch * 2 - ticksToMatch;
+  }
+}
+
+void hostAdvanceTime(uint64_t us)
+{
+  if((TCCR1B.value & 0x07) == _BV(CS11))
+    advanceTimer1(us);
+  else
+    hostTimeMicros += us;
+  if(hostOnTimeAdvance != NULL)
+    hostOnTimeAdvance();
+  if(hostTimeLimitMicros != 0 && hostTimeMicros > hostTimeLimitMicros)
+  {
+    hostTimeLimitMicros = 0; //prevent re-entry
+    if(hostOnTimeLimit != NULL)
+      hostOnTimeLimit();
+    else
+    {
+      fprintf(stderr, "host: virtual time limit reached at %llu us\n", (unsigned long long) hostTimeMicros);
+      exit(2);
+    }
+  }
+}
+
+unsigned long millis()
+{
+  hostAdvanceTime(HOST_TIME_READ_COST_US);
+  return (uint32_t)(hostTimeMicros / 1000);
+}
+
+unsigned long micros()
+{
+  hostAdvanceTime(HOST_TIME_READ_COST_US);
+  return (uint32_t) hostTimeMicros;
+}
+
+void yield()
+{
+}
+
+//Long waits advance in steps of 1 ms so the host sees time pass at that granularity
+void delay(unsigned long ms)
+{
+  while(ms--)
+    hostAdvanceTime(1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  while(us > 1000)
+  {
+    hostAdvanceTime(1000);
+    us -= 1000;
+  }
+  hostAdvanceTime(us);
+}
+
+//==================================================================================================
+//============================ Pins ================================================================
+
+#define LEVEL_UNDRIVEN 0xFF
+
+uint8_t  hostPinMode[NUM_DIGITAL_PINS];
+uint8_t  hostPinLevel[NUM_DIGITAL_PINS];
+uint8_t  hostPinOutput[NUM_DIGITAL_PINS];
+uint16_t hostAnalogValue[NUM_ANALOG_INPUTS];
+void (*hostOnPinMode)(uint8_t pin, uint8_t mode) = NULL;
+void (*hostOnDigitalWrite)(uint8_t pin, uint8_t val) = NULL;
+
+volatile uint8_t hostPinRegister[NUM_DIGITAL_PINS];
+
+uint16_t hostToneFrequency = 0;
+uint32_t hostToneCount = 0;
+
+HostPort PORTA, PORTB, PORTC, PORTD, PORTE, PORTF, PORTG, PORTH, PORTJ, PORTK, PORTL;
+HostPort DDRA, DDRB, DDRC, DDRD, DDRE, DDRF, DDRG, DDRH, DDRJ, DDRK, DDRL;
+HostPort PINA, PINB, PINC, PIND, PINE, PINF, PING, PINH, PINJ, PINK, PINL;
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  if(pin >= NUM_DIGITAL_PINS)
+    return;
+  hostPinMode[pin] = mode;
+  if(hostOnPinMode != NULL)
+    hostOnPinMode(pin, mode);
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  if(pin >= NUM_DIGITAL_PINS)
+    return;
+  hostPinOutput[pin] = val ? HIGH : LOW;
+  if(hostOnDigitalWrite != NULL)
+    hostOnDigitalWrite(pin, hostPinOutput[pin]);
+}
+
+int digitalRead(uint8_t pin)
+{
+  if(pin >= NUM_DIGITAL_PINS)
+    return LOW;
+  if(hostPinLevel[pin] != LEVEL_UNDRIVEN)
+    return hostPinLevel[pin];
+  if(hostPinMode[pin] == OUTPUT)
+    return hostPinOutput[pin];
+  if(hostPinMode[pin] == INPUT_PULLUP)
+    return HIGH;
+  return LOW;
+}
+
+int analogRead(uint8_t pin)
+{
+  if(pin >= A0)
+    pin -= A0;
+  hostAdvanceTime(HOST_ADC_CONVERSION_US);
+  if(pin >= NUM_ANALOG_INPUTS)
+    return 0;
+  return hostAnalogValue[pin];
+}
+
+void analogWrite(uint8_t pin, int val)
+{
+  if(pin < NUM_DIGITAL_PINS)
+    hostPinOutput[pin] = (uint8_t) val;
+}
+
+void analogReference(uint8_t mode)
+{
+  (void) mode;
+}
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode)
+{
+  (void) interruptNum;
+  (void) userFunc;
+  (void) mode;
+}
+
+void detachInterrupt(uint8_t interruptNum)
+{
+  (void) interruptNum;
+}
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration)
+{
+  (void) pin;
+  (void) duration;
+  hostToneFrequency = frequency;
+  hostToneCount++;
+}
+
+void noTone(uint8_t pin)
+{
+  (void) pin;
+  hostToneFrequency = 0;
+}
+
+void hostSetDigitalInput(uint8_t pin, uint8_t level)
+{
+  if(pin < NUM_DIGITAL_PINS)
+    hostPinLevel[pin] = level;
+}
+
+void hostSetAnalogInput(uint8_t pin, uint16_t value)
+{
+  if(pin >= A0)
+    pin -= A0;
+  if(pin < NUM_ANALOG_INPUTS)
+    hostAnalogValue[pin] = value > 1023 ? 1023 : value;
+}
+
+void hostResetHardware()
+{
+  hostTimeMicros = 0;
+  memset(hostPinMode, INPUT, sizeof(hostPinMode));
+  memset(hostPinLevel, LEVEL_UNDRIVEN, sizeof(hostPinLevel));
+  memset(hostPinOutput, LOW, sizeof(hostPinOutput));
+  for(uint8_t i = 0; i < NUM_ANALOG_INPUTS; i++)
+    hostAnalogValue[i] = 512;
+  HostPort *pinRegs[] = {&PINA, &PINB, &PINC, &PIND, &PINE, &PINF, &PING, &PINH, &PINJ, &PINK, &PINL};
+  for(uint8_t i = 0; i < sizeof(pinRegs) / sizeof(pinRegs[0]); i++)
+    pinRegs[i]->value = 0xFF;
+  TCCR1A.value = TCCR1B.value = TIFR1.value = TIMSK1.value = 0;
+  TCNT1 = OCR1A = 0;
+}
+
+void hostEraseEeproms()
+{
+  memset(hostEeprom, 0xFF, sizeof(hostEeprom));
+  memset(hostExtEeprom, 0xFF, HOST_EXT_EEPROM_MAX_SIZE);
+  hostEepromWriteCount = 0;
+  hostExtEepromWriteCount = 0;
+}
+
+//==================================================================================================
+//============================ Math and AVR libc extras =============================================
+
+static uint32_t randomState = 1;
+
+static long nextRandom()
+{
+  //Park-Miller minimal standard generator, as used by avr-libc random()
+  int32_t hi = randomState / 127773;
+  int32_t lo = randomState % 127773;
+  int32_t x = 16807 * lo - 2836 * hi;
+  if(x < 0)
+    x += 0x7fffffff;
+  randomState = x;
+  return x;
+}
+
+long random(long howbig)
+{
+  if(howbig == 0)
+    return 0;
+  return nextRandom() % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+  if(howsmall >= howbig)
+    return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed)
+{
+  if(seed != 0)
+    randomState = seed;
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+char* ultoa(unsigned long val, char* s, int radix)
+{
+  char tmp[33];
+  uint8_t len = 0;
+  do {
+    uint8_t digit = val % radix;
+    tmp[len++] = digit < 10 ? '0' + digit : 'a' + digit - 10;
+    val /= radix;
+  } while(val > 0);
+  for(uint8_t i = 0; i < len; i++)
+    s[i] = tmp[len - 1 - i];
+  s[len] = '\0';
+  return s;
+}
+
+char* ltoa(long val, char* s, int radix)
+{
+  if(val < 0 && radix == 10)
+  {
+    s[0] = '-';
+    ultoa(-(unsigned long) val, s + 1, radix);
+    return s;
+  }
+  return ultoa((unsigned long) val, s, radix);
+}
+
+//int is 16 bits on the AVR, keep the same wrap-around for non-decimal radixes
+char* itoa(int val, char* s, int radix)
+{
+  if(val < 0 && radix == 10)
+    return ltoa(val, s, radix);
+  return ultoa((uint16_t) val, s, radix);
+}
+
+char* utoa(unsigned int val, char* s, int radix)
+{
+  return ultoa((uint16_t) val, s, radix);
+}
+
+size_t strlcpy_P(char *dst, const char *src, size_t size)
+{
+  size_t len = strlen(src);
+  if(size > 0)
+  {
+    size_t n = (len >= size) ? size - 1 : len;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+
+size_t strlcat_P(char *dst, const char *src, size_t size)
+{
+  size_t dlen = strnlen(dst, size);
+  if(dlen == size)
+    return size + strlen(src);
+  return dlen + strlcpy_P(dst + dlen, src, size - dlen);
+}
+
+#if defined(HOST_NEEDS_STRLCPY)
+size_t strlcpy(char *dst, const char *src, size_t size)
+{
+  return strlcpy_P(dst, src, size);
+}
+
+size_t strlcat(char *dst, const char *src, size_t size)
+{
+  return strlcat_P(dst, src, size);
+}
+#endif
+
+uint8_t hostEeprom[HOST_EEPROM_SIZE];
+uint32_t hostEepromWriteCount = 0;
+
+//Linker symbols used by the firmware to estimate free RAM
+int __heap_start;
+int *__brkval;
+
+//==================================================================================================
+//============================ Print ===============================================================
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+  size_t n = 0;
+  while(size--)
+  {
+    if(write(*buffer++))
+      n++;
+    else
+      break;
+  }
+  return n;
+}
+
+size_t Print::print(const __FlashStringHelper *ifsh)
+{
+  return write(reinterpret_cast<const char *>(ifsh));
+}
+
+size_t Print::print(const char str[])           { return write(str); }
+size_t Print::print(char c)                     { return write((uint8_t) c); }
+size_t Print::print(unsigned char b, int base)  { return print((unsigned long) b, base); }
+size_t Print::print(int n, int base)            { return print((long) n, base); }
+size_t Print::print(unsigned int n, int base)   { return print((unsigned long) n, base); }
+
+size_t Print::print(long n, int base)
+{
+  if(base == 0)
+    return write((uint8_t) n);
+  else if(base == 10)
+  {
+    if(n < 0)
+    {
+      int t = print('-');
+      n = -n;
+      return printNumber(n, 10) + t;
+    }
+    return printNumber(n, 10);
+  }
+  else
+    return printNumber(n, base);
+}
+
+size_t Print::print(unsigned long n, int base)
+{
+  if(base == 0)
+    return write((uint8_t) n);
+  return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits)       { return printFloat(n, digits); }
+
+size_t Print::println(const __FlashStringHelper *ifsh) { size_t n = print(ifsh); return n + println(); }
+size_t Print::println(const char c[])           { size_t n = print(c); return n + println(); }
+size_t Print::println(char c)                   { size_t n = print(c); return n + println(); }
+size_t Print::println(unsigned char b, int base){ size_t n = print(b, base); return n + println(); }
+size_t Print::println(int num, int base)        { size_t n = print(num, base); return n + println(); }
+size_t Print::println(unsigned int num, int base){ size_t n = print(num, base); return n + println(); }
+size_t Print::println(long num, int base)       { size_t n = print(num, base); return n + println(); }
+size_t Print::println(unsigned long num, int base){ size_t n = print(num, base); return n + println(); }
+size_t Print::println(double num, int digits)   { size_t n = print(num, digits); return n + println(); }
+size_t Print::println()                         { return write("\r\n"); }
+
+size_t Print::printNumber(unsigned long n, uint8_t base)
+{
+  char buf[8 * sizeof(long) + 1];
+  char *str = &buf[sizeof(buf) - 1];
+  *str = '\0';
+  if(base < 2)
+    base = 10;
+  do {
+    char c = n % base;
+    n /= base;
+    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+  } while(n);
+  return write(str);
+}
+
+size_t Print::printFloat(double number, uint8_t digits)
+{
+  size_t n = 0;
+  if(isnan(number)) return print("nan");
+  if(isinf(number)) return print("inf");
+  if(number > 4294967040.0) return print("ovf");
+  if(number < -4294967040.0) return print("ovf");
+  if(number < 0.0)
+  {
+    n += print('-');
+    number = -number;
+  }
+  double rounding = 0.5;
+  for(uint8_t i = 0; i < digits; ++i)
+    rounding /= 10.0;
+  number += rounding;
+  unsigned long int_part = (unsigned long) number;
+  double remainder = number - (double) int_part;
+  n += print(int_part);
+  if(digits > 0)
+    n += print('.');
+  while(digits-- > 0)
+  {
+    remainder *= 10.0;
+    unsigned int toPrint = (unsigned int) remainder;
+    n += print(toPrint);
+    remainder -= toPrint;
+  }
+  return n;
+}
+
+//==================================================================================================
+//============================ Serial ==============================================================
+
+HardwareSerial Serial;
+HardwareSerial Serial1;
+
+HardwareSerial::HardwareSerial()
+{
+  baudRate = 0;
+  rxOverflowCount = 0;
+  rxHead = rxCount = 0;
+  txHead = txCount = 0;
+}
+
+int HardwareSerial::available()
+{
+  return rxCount;
+}
+
+int HardwareSerial::read()
+{
+  if(rxCount == 0)
+    return -1;
+  uint8_t c = rxBuff[rxHead];
+  rxHead = (rxHead + 1) % SERIAL_RX_BUFFER_SIZE;
+  rxCount--;
+  return c;
+}
+
+int HardwareSerial::peek()
+{
+  if(rxCount == 0)
+    return -1;
+  return rxBuff[rxHead];
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  if(txCount == SERIAL_TX_CAPTURE_SIZE) //drop oldest
+  {
+    txHead = (txHead + 1) % SERIAL_TX_CAPTURE_SIZE;
+    txCount--;
+  }
+  txBuff[(txHead + txCount) % SERIAL_TX_CAPTURE_SIZE] = c;
+  txCount++;
+  return 1;
+}
+
+size_t HardwareSerial::hostInject(const uint8_t *data, size_t len)
+{
+  size_t n = 0;
+  for(; n < len; n++)
+  {
+    if(rxCount == SERIAL_RX_BUFFER_SIZE)
+    {
+      rxOverflowCount += len - n;
+      break;
+    }
+    rxBuff[(rxHead + rxCount) % SERIAL_RX_BUFFER_SIZE] = data[n];
+    rxCount++;
+  }
+  return n;
+}
+
+size_t HardwareSerial::hostTake(uint8_t *data, size_t maxLen)
+{
+  size_t n = 0;
+  while(n < maxLen && txCount > 0)
+  {
+    data[n++] = txBuff[txHead];
+    txHead = (txHead + 1) % SERIAL_TX_CAPTURE_SIZE;
+    txCount--;
+  }
+  return n;
+}
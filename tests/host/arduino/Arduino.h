@@ -0,0 +1,241 @@
+/*
+ * Arduino.h (host shim)
+ *
+ * Minimal stand-in for the Arduino AVR core so that the firmware sources can be
+ * compiled and run natively on a Linux build machine.
+ * - Time is virtual and only advances when the firmware asks for it
+ *   (millis, micros, delay, delayMicroseconds, analogRead).
+ * - Pins, analog inputs and the AVR port registers are plain memory that the
+ *   host driver reads and writes through HostHAL.h
+ * - PROGMEM is ordinary memory, the pgm_read_xxx accessors are plain loads.
+ */
+
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+#include <avr/pgmspace.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef unsigned int word;
+
+//--- Constants
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define PI         3.1415926535897932384626433832795
+#define HALF_PI    1.5707963267948966192313216916398
+#define TWO_PI     6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define F_CPU 16000000UL
+
+#if defined(__AVR_ATmega328P__)
+
+//--- ATmega328P (Arduino Uno, Nano, Pro Mini) analog pin numbers
+//A6 and A7 are analog inputs only
+
+#define NUM_DIGITAL_PINS 20
+#define NUM_ANALOG_INPUTS 8
+
+#define A0  14
+#define A1  15
+#define A2  16
+#define A3  17
+#define A4  18
+#define A5  19
+#define A6  20
+#define A7  21
+
+#else
+
+//--- ATmega2560 (Arduino Mega) analog pin numbers
+
+#define NUM_DIGITAL_PINS 70
+#define NUM_ANALOG_INPUTS 16
+
+#define A0  54
+#define A1  55
+#define A2  56
+#define A3  57
+#define A4  58
+#define A5  59
+#define A6  60
+#define A7  61
+#define A8  62
+#define A9  63
+#define A10 64
+#define A11 65
+#define A12 66
+#define A13 67
+#define A14 68
+#define A15 69
+
+#endif
+
+//--- Analog reference, interrupt modes
+
+#define DEFAULT  1
+#define EXTERNAL 0
+#define INTERNAL 3
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+//--- Binary constants, only the short ones are provided
+
+#define B0    0
+#define B1    1
+#define B10   2
+#define B11   3
+#define B100  4
+#define B101  5
+#define B110  6
+#define B111  7
+#define B1000 8
+
+//--- Helper macros
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define radians(deg) ((deg)*DEG_TO_RAD)
+#define degrees(rad) ((rad)*RAD_TO_DEG)
+#define sq(x) ((x)*(x))
+
+#define lowByte(w) ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+#define _BV(b) (1 << (b))
+
+#define clockCyclesPerMicrosecond() (F_CPU / 1000000L)
+
+#define interrupts()
+#define noInterrupts()
+#define sei()
+#define cli()
+
+//--- Digital and analog IO
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int  digitalRead(uint8_t pin);
+int  analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+
+void analogReference(uint8_t mode);
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration = 0);
+void noTone(uint8_t pin);
+
+//--- External interrupts
+//Pin change interrupts are not emulated, attaching a handler has no effect.
+
+#define digitalPinToInterrupt(p) ((p) == 2 ? 0 : ((p) == 3 ? 1 : -1))
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode);
+void detachInterrupt(uint8_t interruptNum);
+
+//--- Time
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+//--- Math
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+//--- Characters and AVR libc extras
+
+inline bool isDigit(int c) { return isdigit(c) != 0; }
+inline bool isAlpha(int c) { return isalpha(c) != 0; }
+inline bool isSpace(int c) { return isspace(c) != 0; }
+
+char* itoa(int val, char* s, int radix);
+char* utoa(unsigned int val, char* s, int radix);
+char* ltoa(long val, char* s, int radix);
+char* ultoa(unsigned long val, char* s, int radix);
+
+//strlcpy and strlcat are in avr-libc, glibc only has them from version 2.38
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+  #define HOST_NEEDS_STRLCPY
+  size_t strlcpy(char *dst, const char *src, size_t size);
+  size_t strlcat(char *dst, const char *src, size_t size);
+#endif
+
+//--- Port registers
+//Direct port access in the firmware is done with statements like PORTA = x, DDRL = 0 or
+//reading PINL. HostPort behaves like a byte register and counts the writes made to it.
+
+struct HostPort
+{
+  volatile uint8_t value;
+  uint32_t writeCount;
+
+  HostPort& operator=(uint8_t v) { value = v; writeCount++; return *this; }
+  HostPort& operator|=(uint8_t v) { value |= v; writeCount++; return *this; }
+  HostPort& operator&=(uint8_t v) { value &= v; writeCount++; return *this; }
+  HostPort& operator^=(uint8_t v) { value ^= v; writeCount++; return *this; }
+  operator uint8_t() const { return value; }
+};
+
+extern HostPort PORTA, PORTB, PORTC, PORTD, PORTE, PORTF, PORTG, PORTH, PORTJ, PORTK, PORTL;
+extern HostPort DDRA, DDRB, DDRC, DDRD, DDRE, DDRF, DDRG, DDRH, DDRJ, DDRK, DDRL;
+extern HostPort PINA, PINB, PINC, PIND, PINE, PINF, PING, PINH, PINJ, PINK, PINL;
+
+//Pins accessed through portOutputRegister() each get a register of their own.
+//This is enough for the bit-banged control lines of the LCD drivers.
+extern volatile uint8_t hostPinRegister[NUM_DIGITAL_PINS];
+
+#define digitalPinToPort(P)        (P)
+#define digitalPinToBitMask(P)     ((uint8_t) 0x01)
+#define portOutputRegister(P)      (&hostPinRegister[(P)])
+
+//--- Timer1
+//Enough of the 16 bit timer for the Servo library: normal mode, clk/8 prescaler and the
+//output compare A interrupt. TCNT1 counts as the virtual clock advances.
+
+extern HostPort TCCR1A, TCCR1B, TIFR1, TIMSK1;
+extern volatile uint16_t TCNT1, OCR1A;
+extern uint8_t SREG;
+
+#define CS10   0
+#define CS11   1
+#define CS12   2
+#define OCF1A  1
+#define OCIE1A 1
+
+//--- Serial
+
+#include "Print.h"
+#include "HardwareSerial.h"
+
+#endif
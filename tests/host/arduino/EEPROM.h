@@ -0,0 +1,60 @@
+/*
+ * EEPROM.h (host shim)
+ * Internal EEPROM of the ATmega2560 (4 KB) or ATmega328P (1 KB), backed by an array.
+ * Writes are counted so the host can report EEPROM wear.
+ */
+
+#ifndef _HOST_EEPROM_H_
+#define _HOST_EEPROM_H_
+
+#include <stdint.h>
+
+#if defined(__AVR_ATmega328P__)
+  #define HOST_EEPROM_SIZE 1024
+#else
+  #define HOST_EEPROM_SIZE 4096
+#endif
+
+extern uint8_t hostEeprom[HOST_EEPROM_SIZE];
+extern uint32_t hostEepromWriteCount;
+
+struct EEPROMClass
+{
+  uint8_t read(int idx) { return hostEeprom[idx]; }
+
+  void write(int idx, uint8_t val)
+  {
+    hostEeprom[idx] = val;
+    hostEepromWriteCount++;
+  }
+
+  void update(int idx, uint8_t val)
+  {
+    if(hostEeprom[idx] != val)
+      write(idx, val);
+  }
+
+  uint16_t length() { return HOST_EEPROM_SIZE; }
+
+  uint8_t& operator[](int idx) { return hostEeprom[idx]; }
+
+  template <typename T> T &get(int idx, T &t)
+  {
+    uint8_t *ptr = (uint8_t *) &t;
+    for(int count = sizeof(T); count; --count)
+      *ptr++ = read(idx++);
+    return t;
+  }
+
+  template <typename T> const T &put(int idx, const T &t)
+  {
+    const uint8_t *ptr = (const uint8_t *) &t;
+    for(int count = sizeof(T); count; --count)
+      update(idx++, *ptr++);
+    return t;
+  }
+};
+
+static EEPROMClass EEPROM __attribute__((unused));
+
+#endif
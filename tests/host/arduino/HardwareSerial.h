@@ -0,0 +1,52 @@
+/*
+ * HardwareSerial.h (host shim)
+ * The receive side has the same 64 byte capacity as the AVR core, bytes that do
+ * not fit are dropped. Transmitted bytes are kept until the host driver takes them.
+ */
+
+#ifndef _HOST_HARDWARESERIAL_H_
+#define _HOST_HARDWARESERIAL_H_
+
+#include "Print.h"
+
+#define SERIAL_RX_BUFFER_SIZE 64
+#define SERIAL_TX_CAPTURE_SIZE 4096
+
+class HardwareSerial : public Stream
+{
+  public:
+    HardwareSerial();
+
+    void begin(unsigned long baud) { baudRate = baud; }
+    void begin(unsigned long baud, uint8_t) { baudRate = baud; }
+    void end() {}
+
+    int available();
+    int read();
+    int peek();
+    int availableForWrite() { return SERIAL_TX_CAPTURE_SIZE - txCount; }
+
+    size_t write(uint8_t c);
+    using Print::write;
+
+    operator bool() { return true; }
+
+    //--- Host side
+    size_t hostInject(const uint8_t *data, size_t len); //returns the number of bytes accepted
+    size_t hostTake(uint8_t *data, size_t maxLen);      //removes and returns transmitted bytes
+    size_t hostPendingTx() { return txCount; }
+
+    unsigned long baudRate;
+    uint32_t rxOverflowCount;
+
+  private:
+    uint8_t rxBuff[SERIAL_RX_BUFFER_SIZE];
+    uint16_t rxHead, rxCount;
+    uint8_t txBuff[SERIAL_TX_CAPTURE_SIZE];
+    uint16_t txHead, txCount;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+
+#endif
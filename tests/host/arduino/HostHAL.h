@@ -0,0 +1,58 @@
+/*
+ * HostHAL.h
+ * Host side control of the Arduino shim. Used by the host drivers to feed
+ * inputs to the firmware and to observe what it does.
+ */
+
+#ifndef _HOST_HAL_H_
+#define _HOST_HAL_H_
+
+#include "Arduino.h"
+
+//--- Virtual clock
+//Calls to millis() and micros() each take HOST_TIME_READ_COST_US, analogRead() takes
+//HOST_ADC_CONVERSION_US and each SPI byte HOST_SPI_TRANSFER_US, so busy-wait loops in
+//the firmware always make progress.
+
+#define HOST_TIME_READ_COST_US  4
+#define HOST_ADC_CONVERSION_US  112
+#define HOST_SPI_TRANSFER_US    1
+
+extern uint64_t hostTimeMicros;
+void hostAdvanceTime(uint64_t us);
+
+//Called every time the clock advances. Lets the host change inputs at exact virtual
+//times, even while the firmware is inside one of its blocking loops.
+extern void (*hostOnTimeAdvance)();
+
+//Called when the virtual clock passes hostTimeLimitMicros (0 disables the limit).
+//Guards against blocking firmware loops that would otherwise never return.
+extern uint64_t hostTimeLimitMicros;
+extern void (*hostOnTimeLimit)();
+
+//--- Pins
+extern uint8_t  hostPinMode[NUM_DIGITAL_PINS];
+extern uint8_t  hostPinLevel[NUM_DIGITAL_PINS];   //level read by digitalRead
+extern uint8_t  hostPinOutput[NUM_DIGITAL_PINS];  //last value given to digitalWrite/analogWrite
+extern uint16_t hostAnalogValue[NUM_ANALOG_INPUTS];
+
+void hostSetDigitalInput(uint8_t pin, uint8_t level);
+void hostSetAnalogInput(uint8_t pin, uint16_t value); //pin is A0..A15 or 0..15
+
+//Called whenever the firmware changes a pin mode, e.g. to detect the power latch release
+extern void (*hostOnPinMode)(uint8_t pin, uint8_t mode);
+
+//Called on every digitalWrite, including those made from interrupt handlers
+extern void (*hostOnDigitalWrite)(uint8_t pin, uint8_t val);
+
+//--- Tone
+extern uint16_t hostToneFrequency;
+extern uint32_t hostToneCount;
+
+//--- Reset all state to power-on defaults. EEPROM contents are kept.
+void hostResetHardware();
+
+//--- Erase the internal and external EEPROMs (all bytes 0xFF, as shipped)
+void hostEraseEeproms();
+
+#endif
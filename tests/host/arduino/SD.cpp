@@ -0,0 +1,212 @@
+#include <dirent.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SD.h"
+
+SDClass SD;
+char hostSdRoot[256] = "";
+
+static bool hostPathFor(const char *filepath, char *out, size_t outLen)
+{
+  if(hostSdRoot[0] == '\0')
+    return false;
+  snprintf(out, outLen, "%s/%s", hostSdRoot, (filepath[0] == '/') ? filepath + 1 : filepath);
+  return true;
+}
+
+static bool isHostDir(const char *hostPath)
+{
+  struct stat st;
+  return stat(hostPath, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+//==================================================================================================
+
+File::File()
+{
+  isOpen = false;
+  isDir = false;
+  fp = NULL;
+  path[0] = '\0';
+  fileName[0] = '\0';
+  dirIndex = 0;
+}
+
+File::File(const char *hostPath, const char *name, uint8_t mode)
+{
+  isOpen = false;
+  isDir = isHostDir(hostPath);
+  fp = NULL;
+  dirIndex = 0;
+  strlcpy_P(path, hostPath, sizeof(path));
+  const char *base = strrchr(name, '/');
+  strlcpy_P(fileName, base ? base + 1 : name, sizeof(fileName));
+  if(isDir)
+    isOpen = true;
+  else
+  {
+    if(mode == FILE_WRITE)
+    {
+      //FILE_WRITE on the SD library opens for reading and appending
+      fp = fopen(hostPath, "a+b");
+      if(fp)
+        fseek(fp, 0, SEEK_END);
+    }
+    else
+      fp = fopen(hostPath, "rb");
+    isOpen = (fp != NULL);
+  }
+}
+
+size_t File::write(uint8_t c)
+{
+  return write(&c, 1);
+}
+
+size_t File::write(const uint8_t *buf, size_t size)
+{
+  if(!fp)
+    return 0;
+  return fwrite(buf, 1, size, fp);
+}
+
+int File::available()
+{
+  if(!fp)
+    return 0;
+  uint32_t remaining = size() - position();
+  return remaining > 0x7FFF ? 0x7FFF : remaining;
+}
+
+int File::read()
+{
+  if(!fp)
+    return -1;
+  int c = fgetc(fp);
+  return (c == EOF) ? -1 : c;
+}
+
+int File::read(void *buf, uint16_t nbyte)
+{
+  if(!fp)
+    return -1;
+  return fread(buf, 1, nbyte, fp);
+}
+
+int File::peek()
+{
+  if(!fp)
+    return -1;
+  int c = fgetc(fp);
+  if(c == EOF)
+    return -1;
+  ungetc(c, fp);
+  return c;
+}
+
+void File::flush()
+{
+  if(fp)
+    fflush(fp);
+}
+
+bool File::seek(uint32_t pos)
+{
+  return fp && fseek(fp, pos, SEEK_SET) == 0;
+}
+
+uint32_t File::position()
+{
+  return fp ? ftell(fp) : 0;
+}
+
+uint32_t File::size()
+{
+  if(!fp)
+    return 0;
+  long pos = ftell(fp);
+  fseek(fp, 0, SEEK_END);
+  long len = ftell(fp);
+  fseek(fp, pos, SEEK_SET);
+  return len;
+}
+
+void File::close()
+{
+  if(fp)
+    fclose(fp);
+  fp = NULL;
+  isOpen = false;
+}
+
+File File::openNextFile(uint8_t mode)
+{
+  if(!isDir || !isOpen)
+    return File();
+  DIR *dir = opendir(path);
+  if(!dir)
+    return File();
+  //Entries are returned in the order the host lists them, skipping . and ..
+  uint16_t idx = 0;
+  struct dirent *ent;
+  File result;
+  while((ent = readdir(dir)) != NULL)
+  {
+    if(strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0)
+      continue;
+    if(idx++ == dirIndex)
+    {
+      char entryPath[sizeof(path) + 256];
+      snprintf(entryPath, sizeof(entryPath), "%s/%s", path, ent->d_name);
+      result = File(entryPath, ent->d_name, mode);
+      dirIndex++;
+      break;
+    }
+  }
+  closedir(dir);
+  return result;
+}
+
+//==================================================================================================
+
+bool SDClass::begin(uint8_t csPin)
+{
+  (void) csPin;
+  return hostSdRoot[0] != '\0' && isHostDir(hostSdRoot);
+}
+
+File SDClass::open(const char *filename, uint8_t mode)
+{
+  char hostPath[320];
+  if(!hostPathFor(filename, hostPath, sizeof(hostPath)))
+    return File();
+  return File(hostPath, filename, mode);
+}
+
+bool SDClass::exists(const char *filepath)
+{
+  char hostPath[320];
+  struct stat st;
+  return hostPathFor(filepath, hostPath, sizeof(hostPath)) && stat(hostPath, &st) == 0;
+}
+
+bool SDClass::mkdir(const char *filepath)
+{
+  char hostPath[320];
+  return hostPathFor(filepath, hostPath, sizeof(hostPath)) && ::mkdir(hostPath, 0755) == 0;
+}
+
+bool SDClass::remove(const char *filepath)
+{
+  char hostPath[320];
+  return hostPathFor(filepath, hostPath, sizeof(hostPath)) && ::remove(hostPath) == 0;
+}
+
+bool SDClass::rmdir(const char *filepath)
+{
+  char hostPath[320];
+  return hostPathFor(filepath, hostPath, sizeof(hostPath)) && ::rmdir(hostPath) == 0;
+}
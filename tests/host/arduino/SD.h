@@ -0,0 +1,66 @@
+/*
+ * SD.h (host shim)
+ * The card is a directory on the host. When hostSdRoot is empty, SD.begin()
+ * fails as it does on the transmitter with no card inserted.
+ */
+
+#ifndef _HOST_SD_H_
+#define _HOST_SD_H_
+
+#include <stdio.h>
+#include "Arduino.h"
+
+#define FILE_READ  0x01
+#define FILE_WRITE 0x02
+
+extern char hostSdRoot[256];
+
+class File : public Stream
+{
+  public:
+    File();
+    File(const char *hostPath, const char *name, uint8_t mode);
+
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buf, size_t size);
+    using Print::write;
+
+    int available();
+    int read();
+    int read(void *buf, uint16_t nbyte);
+    int peek();
+    void flush();
+    bool seek(uint32_t pos);
+    uint32_t position();
+    uint32_t size();
+    void close();
+    operator bool() { return isOpen; }
+
+    const char *name() { return fileName; }
+    bool isDirectory() { return isDir; }
+    File openNextFile(uint8_t mode = FILE_READ);
+    void rewindDirectory() { dirIndex = 0; }
+
+  private:
+    bool isOpen;
+    bool isDir;
+    FILE *fp;
+    char path[320];
+    char fileName[16];
+    uint16_t dirIndex;
+};
+
+class SDClass
+{
+  public:
+    bool begin(uint8_t csPin);
+    File open(const char *filename, uint8_t mode = FILE_READ);
+    bool exists(const char *filepath);
+    bool mkdir(const char *filepath);
+    bool remove(const char *filepath);
+    bool rmdir(const char *filepath);
+};
+
+extern SDClass SD;
+
+#endif
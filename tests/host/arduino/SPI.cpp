@@ -0,0 +1,17 @@
+#include "SPI.h"
+#include "HostHAL.h"
+
+SPIClass SPI;
+
+uint8_t (*hostOnSpiTransfer)(uint8_t index, uint8_t data) = NULL;
+
+//--------------------------------------------------------------------------------------------------
+
+uint8_t SPIClass::transfer(uint8_t data)
+{
+  hostAdvanceTime(HOST_SPI_TRANSFER_US);
+  uint8_t index = transferIndex++;
+  if(hostOnSpiTransfer == NULL)
+    return 0;
+  return hostOnSpiTransfer(index, data);
+}
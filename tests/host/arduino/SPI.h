@@ -0,0 +1,46 @@
+/*
+ * SPI.h (host shim)
+ * The SD card is emulated at a higher level, see SD.h. Other devices on the bus
+ * attach through hostOnSpiTransfer, e.g. the emulated LoRa module in SX127x.cpp.
+ * Each byte transferred takes HOST_SPI_TRANSFER_US of virtual time.
+ */
+
+#ifndef _HOST_SPI_H_
+#define _HOST_SPI_H_
+
+#include <stdint.h>
+
+#define SPI_MODE0 0x00
+
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+//Called for every byte clocked out, index is the position of the byte within the
+//current transaction. Returns the byte clocked in. When NULL, reads return 0.
+extern uint8_t (*hostOnSpiTransfer)(uint8_t index, uint8_t data);
+
+class SPISettings
+{
+  public:
+    SPISettings() {}
+    SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass
+{
+  public:
+    void begin() {}
+    void end() {}
+    void beginTransaction(SPISettings) { transferIndex = 0; }
+    void endTransaction() {}
+    uint8_t transfer(uint8_t data);
+    void usingInterrupt(int) {}
+    void notUsingInterrupt(int) {}
+
+  private:
+    uint8_t transferIndex;
+};
+
+extern SPIClass SPI;
+
+#endif
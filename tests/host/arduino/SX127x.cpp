@@ -0,0 +1,357 @@
+#include <string.h>
+
+#include "SX127x.h"
+#include "SPI.h"
+#include "HostHAL.h"
+
+//registers used by the LoRa library
+#define REG_FIFO                 0x00
+#define REG_OP_MODE              0x01
+#define REG_FRF_MSB              0x06
+#define REG_FRF_MID              0x07
+#define REG_FRF_LSB              0x08
+#define REG_FIFO_ADDR_PTR        0x0d
+#define REG_FIFO_TX_BASE_ADDR    0x0e
+#define REG_FIFO_RX_BASE_ADDR    0x0f
+#define REG_FIFO_RX_CURRENT_ADDR 0x10
+#define REG_IRQ_FLAGS            0x12
+#define REG_RX_NB_BYTES          0x13
+#define REG_PKT_SNR_VALUE        0x19
+#define REG_PKT_RSSI_VALUE       0x1a
+#define REG_MODEM_CONFIG_1       0x1d
+#define REG_MODEM_CONFIG_2       0x1e
+#define REG_SYMB_TIMEOUT_LSB     0x1f
+#define REG_PREAMBLE_MSB         0x20
+#define REG_PREAMBLE_LSB         0x21
+#define REG_PAYLOAD_LENGTH       0x22
+#define REG_MODEM_CONFIG_3       0x26
+#define REG_RSSI_WIDEBAND        0x2c
+#define REG_VERSION              0x42
+
+#define MODE_MASK                0x07
+#define MODE_STDBY               0x01
+#define MODE_TX                  0x03
+#define MODE_RX_CONTINUOUS       0x05
+#define MODE_RX_SINGLE           0x06
+
+#define IRQ_TX_DONE_MASK         0x08
+#define IRQ_RX_DONE_MASK         0x40
+#define IRQ_RX_TIMEOUT_MASK      0x80
+
+//symbols of preamble the receiver needs to lock on a packet
+#define PREAMBLE_DETECT_SYMBOLS  4
+
+//values reported for every received packet, -60 dBm and 10 dB
+#define PKT_RSSI_VALUE           104
+#define PKT_SNR_VALUE            40
+
+host_radio_stats_t hostRadioStats;
+
+static const host_radio_medium_t *medium = NULL;
+static uint8_t  radioId;
+
+static uint8_t  reg[128];
+static uint8_t  fifo[256];
+static uint8_t  spiAddress;
+
+static uint64_t txEndTime;
+static uint32_t txSeq;
+
+static uint64_t rxStartTime;
+static uint32_t rxCursor; //next packet on the medium to consider
+static bool     rxLocked; //preamble detected, receiving
+
+static uint8_t  rssiNoise = 0x5A;
+
+//==================================================================================================
+
+static const uint32_t bandwidthHz[] = {
+  7800, 10400, 15600, 20800, 31250, 41700, 62500, 125000, 250000, 500000
+};
+
+static uint8_t spreadingFactor() { return reg[REG_MODEM_CONFIG_2] >> 4; }
+static uint8_t bandwidthCode()   { return reg[REG_MODEM_CONFIG_1] >> 4; }
+static bool    implicitHeader()  { return reg[REG_MODEM_CONFIG_1] & 0x01; }
+
+static uint32_t carrier()
+{
+  return ((uint32_t) reg[REG_FRF_MSB] << 16) | ((uint32_t) reg[REG_FRF_MID] << 8) | reg[REG_FRF_LSB];
+}
+
+static uint16_t preambleLength()
+{
+  return ((uint16_t) reg[REG_PREAMBLE_MSB] << 8) | reg[REG_PREAMBLE_LSB];
+}
+
+static uint32_t symbolTimeNs()
+{
+  uint8_t bw = bandwidthCode();
+  if(bw >= sizeof(bandwidthHz) / sizeof(bandwidthHz[0]))
+    bw = 9;
+  return (uint32_t)(((uint64_t) 1000000000 << spreadingFactor()) / bandwidthHz[bw]);
+}
+
+uint32_t hostRadioAirTime(uint8_t payloadLength)
+{
+  int32_t sf = spreadingFactor();
+  int32_t cr = (reg[REG_MODEM_CONFIG_1] >> 1) & 0x07;
+  int32_t ih = implicitHeader();
+  int32_t crcOn = (reg[REG_MODEM_CONFIG_2] >> 2) & 0x01;
+  int32_t lowDataRateOpt = (reg[REG_MODEM_CONFIG_3] >> 3) & 0x01;
+
+  //number of payload symbols, SX1276 datasheet 4.1.1.7
+  int32_t num = 8 * payloadLength - 4 * sf + 28 + 16 * crcOn - 20 * ih;
+  int32_t den = 4 * (sf - 2 * lowDataRateOpt);
+  int32_t payloadSymbols = 8;
+  if(num > 0)
+    payloadSymbols += ((num + den - 1) / den) * (cr + 4);
+
+  //the preamble is followed by 4.25 symbols of sync word
+  uint64_t quarterSymbols = 4 * (uint64_t) preambleLength() + 17 + 4 * (uint64_t) payloadSymbols;
+  return (uint32_t)((quarterSymbols * symbolTimeNs() / 4 + 999) / 1000);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+static void setMode(uint8_t mode)
+{
+  reg[REG_OP_MODE] = (reg[REG_OP_MODE] & ~MODE_MASK) | mode;
+}
+
+static bool canLock(const host_radio_packet_t *p)
+{
+  if(p->senderId == radioId || p->frf != carrier() || p->sf != spreadingFactor() || p->bw != bandwidthCode())
+    return false;
+  if(p->implicitHeader != implicitHeader() || (p->sf == 6 && !p->implicitHeader))
+    return false;
+  uint64_t latestStart = p->startTime;
+  if(p->preambleLength > PREAMBLE_DETECT_SYMBOLS)
+    latestStart += ((uint64_t)(p->preambleLength - PREAMBLE_DETECT_SYMBOLS) * p->symbolTimeNs) / 1000;
+  return rxStartTime <= latestStart;
+}
+
+static bool hasCollided(const host_radio_packet_t *p)
+{
+  if(p->aborted)
+    return true;
+  for(uint32_t seq = medium->oldestSeq(); seq != medium->nextSeq(); seq++)
+  {
+    const host_radio_packet_t *other = medium->packet(seq);
+    if(other == NULL || other->seq == p->seq || other->frf != p->frf)
+      continue;
+    if(other->startTime < p->endTime && other->endTime > p->startTime)
+      return true;
+  }
+  return false;
+}
+
+static void deliver(const host_radio_packet_t *p)
+{
+  uint8_t base = reg[REG_FIFO_RX_BASE_ADDR];
+  for(uint16_t i = 0; i < p->length; i++)
+    fifo[(uint8_t)(base + i)] = p->data[i];
+  reg[REG_FIFO_RX_CURRENT_ADDR] = base;
+  reg[REG_RX_NB_BYTES] = p->length;
+  reg[REG_PKT_RSSI_VALUE] = PKT_RSSI_VALUE;
+  reg[REG_PKT_SNR_VALUE] = PKT_SNR_VALUE;
+  reg[REG_IRQ_FLAGS] |= IRQ_RX_DONE_MASK;
+  hostRadioStats.rxPackets++;
+}
+
+//Brings the modem state up to the current virtual time
+static void update()
+{
+  uint64_t now = hostTimeMicros;
+  uint8_t mode = reg[REG_OP_MODE] & MODE_MASK;
+
+  if(mode == MODE_TX)
+  {
+    if(now >= txEndTime)
+    {
+      setMode(MODE_STDBY);
+      reg[REG_IRQ_FLAGS] |= IRQ_TX_DONE_MASK;
+    }
+    return;
+  }
+
+  if(mode != MODE_RX_SINGLE && mode != MODE_RX_CONTINUOUS)
+    return;
+
+  while(rxCursor != medium->nextSeq())
+  {
+    const host_radio_packet_t *p = medium->packet(rxCursor);
+    if(p == NULL || !canLock(p))
+    {
+      rxCursor++;
+      continue;
+    }
+    uint64_t detectTime = (p->startTime > rxStartTime) ? p->startTime : rxStartTime;
+    detectTime += ((uint64_t) PREAMBLE_DETECT_SYMBOLS * p->symbolTimeNs) / 1000;
+    if(now < detectTime)
+      break;
+    rxLocked = true;
+    if(now < p->endTime)
+      break;
+
+    //packet complete
+    rxCursor++;
+    rxLocked = false;
+    if(hasCollided(p))
+    {
+      hostRadioStats.rxCollisions++;
+      continue;
+    }
+    if(p->implicitHeader && p->length != reg[REG_PAYLOAD_LENGTH])
+      hostRadioStats.rxLengthErrors++;
+    else
+      deliver(p);
+    if(mode == MODE_RX_SINGLE)
+    {
+      setMode(MODE_STDBY);
+      return;
+    }
+  }
+
+  if(mode == MODE_RX_SINGLE && !rxLocked)
+  {
+    uint32_t timeoutSymbols = ((uint32_t)(reg[REG_MODEM_CONFIG_2] & 0x03) << 8) | reg[REG_SYMB_TIMEOUT_LSB];
+    if(now >= rxStartTime + ((uint64_t) timeoutSymbols * symbolTimeNs()) / 1000)
+    {
+      setMode(MODE_STDBY);
+      reg[REG_IRQ_FLAGS] |= IRQ_RX_TIMEOUT_MASK;
+      hostRadioStats.rxTimeouts++;
+    }
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+static void startTransmit()
+{
+  static host_radio_packet_t p;
+  memset(&p, 0, sizeof(p));
+  p.senderId = radioId;
+  p.frf = carrier();
+  p.sf = spreadingFactor();
+  p.bw = bandwidthCode();
+  p.symbolTimeNs = symbolTimeNs();
+  p.preambleLength = preambleLength();
+  p.implicitHeader = implicitHeader();
+  p.length = reg[REG_PAYLOAD_LENGTH];
+  for(uint16_t i = 0; i < p.length; i++)
+    p.data[i] = fifo[(uint8_t)(reg[REG_FIFO_TX_BASE_ADDR] + i)];
+  p.startTime = hostTimeMicros;
+  p.endTime = p.startTime + hostRadioAirTime(p.length);
+
+  txSeq = medium->transmit(&p);
+  txEndTime = p.endTime;
+  hostRadioStats.txPackets++;
+  hostRadioStats.txAirTime += p.endTime - p.startTime;
+}
+
+static void writeOpMode(uint8_t val)
+{
+  uint8_t oldMode = reg[REG_OP_MODE] & MODE_MASK;
+  uint8_t newMode = val & MODE_MASK;
+
+  if(oldMode == MODE_TX && newMode != MODE_TX)
+  {
+    hostRadioStats.txAirTime -= txEndTime - hostTimeMicros;
+    medium->abort(txSeq, hostTimeMicros);
+  }
+
+  reg[REG_OP_MODE] = val;
+
+  if(newMode == MODE_TX && oldMode != MODE_TX)
+    startTransmit();
+  else if((newMode == MODE_RX_SINGLE || newMode == MODE_RX_CONTINUOUS) && newMode != oldMode)
+  {
+    rxStartTime = hostTimeMicros;
+    rxCursor = medium->oldestSeq();
+    rxLocked = false;
+  }
+}
+
+static void writeRegister(uint8_t address, uint8_t val)
+{
+  switch(address)
+  {
+    case REG_FIFO:
+      fifo[reg[REG_FIFO_ADDR_PTR]++] = val;
+      break;
+    case REG_OP_MODE:
+      writeOpMode(val);
+      break;
+    case REG_IRQ_FLAGS:
+      reg[REG_IRQ_FLAGS] &= ~val; //flags are cleared by writing 1
+      break;
+    case REG_FIFO_RX_CURRENT_ADDR:
+    case REG_RX_NB_BYTES:
+    case REG_PKT_SNR_VALUE:
+    case REG_PKT_RSSI_VALUE:
+    case REG_RSSI_WIDEBAND:
+    case REG_VERSION:
+      break; //read only
+    default:
+      reg[address] = val;
+  }
+}
+
+static uint8_t readRegister(uint8_t address)
+{
+  switch(address)
+  {
+    case REG_FIFO:
+      return fifo[reg[REG_FIFO_ADDR_PTR]++];
+    case REG_RSSI_WIDEBAND:
+      rssiNoise = (rssiNoise >> 1) ^ (-(rssiNoise & 1) & 0xB8);
+      return rssiNoise;
+    default:
+      return reg[address];
+  }
+}
+
+//The first byte of a transaction is the address, with bit 7 set for a write
+static uint8_t spiTransfer(uint8_t index, uint8_t data)
+{
+  if(index == 0)
+  {
+    spiAddress = data;
+    return 0;
+  }
+  uint8_t address = spiAddress & 0x7F;
+  update();
+  uint8_t result = 0;
+  if(spiAddress & 0x80)
+    writeRegister(address, data);
+  else
+    result = readRegister(address);
+  if(address != REG_FIFO) //burst access
+    spiAddress = (spiAddress & 0x80) | ((address + 1) & 0x7F);
+  return result;
+}
+
+//==================================================================================================
+
+void hostRadioAttach(uint8_t id, const host_radio_medium_t *radioMedium)
+{
+  medium = radioMedium;
+  radioId = id;
+  memset(&hostRadioStats, 0, sizeof(hostRadioStats));
+  memset(fifo, 0, sizeof(fifo));
+
+  //power-on values of the registers used
+  memset(reg, 0, sizeof(reg));
+  reg[REG_OP_MODE] = MODE_STDBY;
+  reg[REG_FRF_MSB] = 0x6C; //434 MHz
+  reg[REG_FRF_MID] = 0x80;
+  reg[REG_FIFO_TX_BASE_ADDR] = 0x80;
+  reg[REG_MODEM_CONFIG_1] = 0x72; //125 kHz, 4/5, explicit header
+  reg[REG_MODEM_CONFIG_2] = 0x70; //SF7, CRC off
+  reg[REG_SYMB_TIMEOUT_LSB] = 0x64;
+  reg[REG_PREAMBLE_LSB] = 0x08;
+  reg[REG_PAYLOAD_LENGTH] = 0x01;
+  reg[REG_VERSION] = 0x12;
+
+  hostOnSpiTransfer = spiTransfer;
+}
@@ -0,0 +1,69 @@
+/*
+ * SX127x.h (host shim)
+ *
+ * Register level model of a Semtech SX1276/77/78 LoRa module on the SPI bus, so that
+ * the LoRa library compiled into the firmware runs unmodified.
+ *
+ * Transmitted packets are handed to a radio medium provided by the host and shared by
+ * all the emulated modules. Air time follows the modem settings in the registers
+ * (spreading factor, bandwidth, coding rate, header mode, CRC, preamble length) as
+ * given in section 4.1.1 of the SX1276 datasheet.
+ *
+ * The link itself is perfect. A packet is received if the receiver is in RX mode on the
+ * same channel, spreading factor, bandwidth and header mode at least 4 symbols before the
+ * end of the preamble, and stays there until the end of the packet. Packets that overlap on
+ * the same channel are lost. SF6 only works with an implicit header, and a packet with an
+ * implicit header is only received if the receiver expects its exact length. RX single mode times out after RegSymbTimeout symbols without a
+ * preamble, as on the real module.
+ */
+
+#ifndef _HOST_SX127X_H_
+#define _HOST_SX127X_H_
+
+#include <stdint.h>
+
+typedef struct {
+  uint32_t seq;
+  uint8_t  senderId;
+  uint32_t frf;          //carrier frequency, as the value in the RegFrf registers
+  uint8_t  sf;           //spreading factor
+  uint8_t  bw;           //bandwidth, as the code in RegModemConfig1
+  uint32_t symbolTimeNs;
+  uint16_t preambleLength;
+  bool     implicitHeader;
+  bool     aborted;      //transmission cut short by the sender
+  uint64_t startTime;    //in microseconds
+  uint64_t endTime;
+  uint8_t  length;
+  uint8_t  data[255];
+} host_radio_packet_t;
+
+//Implemented by the host. Packets are numbered in the order they start.
+typedef struct {
+  uint32_t (*transmit)(const host_radio_packet_t *packet); //returns the sequence number
+  void     (*abort)(uint32_t seq, uint64_t time);
+  const host_radio_packet_t* (*packet)(uint32_t seq);      //NULL if no longer kept or not sent yet
+  uint32_t (*oldestSeq)();
+  uint32_t (*nextSeq)();
+} host_radio_medium_t;
+
+typedef struct {
+  uint32_t txPackets;
+  uint64_t txAirTime;    //in microseconds
+  uint32_t rxPackets;
+  uint32_t rxCollisions; //packets this module would have received but were lost to overlaps
+  uint32_t rxTimeouts;
+  uint32_t rxLengthErrors; //implicit header packets of another length than the one expected
+} host_radio_stats_t;
+
+extern host_radio_stats_t hostRadioStats;
+
+//Connects the module to the SPI bus and the medium, in its power-on state.
+//The id tells the packets of this module apart from those of the others.
+void hostRadioAttach(uint8_t id, const host_radio_medium_t *medium);
+
+//Air time in microseconds of a packet with the given payload length, using the current
+//modem settings of the module
+uint32_t hostRadioAirTime(uint8_t payloadLength);
+
+#endif
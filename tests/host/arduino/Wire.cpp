@@ -0,0 +1,77 @@
+#include <string.h>
+
+#include "Wire.h"
+
+TwoWire Wire;
+
+uint8_t  hostExtEeprom[HOST_EXT_EEPROM_MAX_SIZE];
+uint32_t hostExtEepromSize = 0;
+uint8_t  hostExtEepromAddress = 0x50;
+uint32_t hostExtEepromWriteCount = 0;
+
+//--------------------------------------------------------------------------------------------------
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+  txAddress = address;
+  txLength = 0;
+}
+
+size_t TwoWire::write(uint8_t data)
+{
+  if(txLength >= BUFFER_LENGTH)
+    return 0;
+  txBuffer[txLength++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity)
+{
+  for(size_t i = 0; i < quantity; i++)
+  {
+    if(!write(data[i]))
+      return i;
+  }
+  return quantity;
+}
+
+//Returns 0 on success, 2 on address NACK, same as the AVR Wire library
+uint8_t TwoWire::endTransmission(bool sendStop)
+{
+  (void) sendStop;
+  if(hostExtEepromSize == 0 || txAddress != hostExtEepromAddress)
+    return 2;
+
+  //The first two bytes are the memory address, the rest is data
+  if(txLength >= 2)
+  {
+    memPointer = (((uint32_t) txBuffer[0] << 8) | txBuffer[1]) % hostExtEepromSize;
+    for(uint8_t i = 2; i < txLength; i++)
+    {
+      //writes wrap around within the page, as on the real device
+      uint32_t pageStart = memPointer - (memPointer % 64);
+      hostExtEeprom[memPointer] = txBuffer[i];
+      memPointer = pageStart + ((memPointer + 1) % 64);
+    }
+    if(txLength > 2)
+      hostExtEepromWriteCount++;
+  }
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop)
+{
+  (void) sendStop;
+  rxIndex = rxLength = 0;
+  if(hostExtEepromSize == 0 || address != hostExtEepromAddress)
+    return 0;
+  if(quantity > BUFFER_LENGTH)
+    quantity = BUFFER_LENGTH;
+  for(uint8_t i = 0; i < quantity; i++)
+  {
+    rxBuffer[i] = hostExtEeprom[memPointer];
+    memPointer = (memPointer + 1) % hostExtEepromSize;
+  }
+  rxLength = quantity;
+  return quantity;
+}
@@ -0,0 +1,56 @@
+/*
+ * Wire.h (host shim)
+ * I2C master with a single emulated 24LCxxx serial EEPROM on the bus.
+ * The device acknowledges at hostExtEepromAddress when hostExtEepromSize is
+ * non-zero, otherwise every transmission is NACKed, as with nothing connected.
+ * Writes complete instantly, so acknowledge polling never waits.
+ */
+
+#ifndef _HOST_WIRE_H_
+#define _HOST_WIRE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BUFFER_LENGTH 32
+
+extern uint8_t  hostExtEeprom[];
+extern uint32_t hostExtEepromSize; //0 means no device
+extern uint8_t  hostExtEepromAddress;
+extern uint32_t hostExtEepromWriteCount;
+
+#define HOST_EXT_EEPROM_MAX_SIZE 65536
+
+class TwoWire
+{
+  public:
+    void begin() {}
+    void end() {}
+    void setClock(uint32_t) {}
+
+    void beginTransmission(uint8_t address);
+    void beginTransmission(int address) { beginTransmission((uint8_t) address); }
+    uint8_t endTransmission(bool sendStop = true);
+
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop = true);
+    uint8_t requestFrom(int address, int quantity) { return requestFrom((uint8_t) address, (uint8_t) quantity); }
+
+    size_t write(uint8_t data);
+    size_t write(const uint8_t *data, size_t quantity);
+
+    int available() { return rxLength - rxIndex; }
+    int read() { return (rxIndex < rxLength) ? rxBuffer[rxIndex++] : -1; }
+    int peek() { return (rxIndex < rxLength) ? rxBuffer[rxIndex] : -1; }
+
+  private:
+    uint8_t txAddress;
+    uint8_t txBuffer[BUFFER_LENGTH];
+    uint8_t txLength;
+    uint8_t rxBuffer[BUFFER_LENGTH];
+    uint8_t rxIndex, rxLength;
+    uint32_t memPointer;
+};
+
+extern TwoWire Wire;
+
+#endif
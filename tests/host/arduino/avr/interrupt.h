@@ -0,0 +1,19 @@
+/*
+ * avr/interrupt.h (host shim)
+ * An interrupt service routine becomes a plain C function with the vector name.
+ * The shim calls the ones it emulates (see Timer1 in Arduino.h) at the virtual
+ * time the interrupt would fire. Interrupts are never masked, as the firmware
+ * only runs between two advances of the virtual clock.
+ */
+
+#ifndef _HOST_INTERRUPT_H_
+#define _HOST_INTERRUPT_H_
+
+#define ISR(vector, ...) extern "C" void vector(void); extern "C" void vector(void)
+
+#ifndef sei
+  #define sei()
+  #define cli()
+#endif
+
+#endif
@@ -0,0 +1,41 @@
+/*
+ * avr/pgmspace.h (host shim)
+ * On the host there is a single address space, so PROGMEM data is ordinary
+ * memory and the _P string functions map to their normal counterparts.
+ */
+
+#ifndef _HOST_PGMSPACE_H_
+#define _HOST_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+
+#define pgm_read_byte(addr)  (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_float(addr) (*(const float *)(addr))
+#define pgm_read_ptr(addr)   (*(void * const *)(addr))
+
+#define pgm_read_byte_near(addr) pgm_read_byte(addr)
+#define pgm_read_word_near(addr) pgm_read_word(addr)
+#define pgm_read_byte_far(addr)  pgm_read_byte(addr)
+#define pgm_get_far_address(var) ((uint32_t)(uintptr_t)&(var))
+
+#define memcpy_P(dst, src, n)      memcpy((dst), (src), (n))
+#define strcpy_P(dst, src)         strcpy((dst), (src))
+#define strncpy_P(dst, src, n)     strncpy((dst), (src), (n))
+#define strcat_P(dst, src)         strcat((dst), (src))
+#define strcmp_P(a, b)             strcmp((a), (b))
+#define strncmp_P(a, b, n)         strncmp((a), (b), (n))
+#define strcasecmp_P(a, b)         strcasecmp((a), (b))
+#define strlen_P(s)                strlen((s))
+
+size_t strlcpy_P(char *dst, const char *src, size_t size);
+size_t strlcat_P(char *dst, const char *src, size_t size);
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ * expo_test.cpp
+ *
+ * Checks calcExpo() and calcRateExpo() of the mtx mixer against the reference
+ * implementation, with its 32-bit divisions, for every input from -500 to 500, every
+ * expo from -100 to 100 and every rate from 0 to 100. The results may differ by 1 at most.
+ *
+ * Usage: expo_test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Arduino.h"
+
+#include "../config.h"
+#include "common.h"
+#include "mixer.h"
+
+//==================================================================================================
+//============================ Reference ===========================================================
+
+//As calcExpo() was, y = (((k*x*x + 250000*(100-k))/250000)*x)/100
+static int16_t calcExpoReference(int16_t input, int16_t expo)
+{
+  if(expo == 0)
+    return input;
+
+  int32_t x = abs(input);
+  int32_t k = abs(expo);
+  if(expo < 0)
+    x -= 500;
+  
+  int32_t y = k*x*x + 250000*(100-k);
+  y /= 250000;
+  y *= x;
+  y /= 100;
+  
+  if(expo < 0)
+    y += 500;
+  if(input < 0)
+    y = -y;
+  
+  return (int16_t) y;
+}
+
+static int16_t calcRateExpoReference(int16_t input, int16_t rate, int16_t expo)
+{
+  return ((int32_t)rate * calcExpoReference(input, expo)) / 100;
+}
+
+//==================================================================================================
+
+int main(int argc, char* argv[])
+{
+  const int16_t tolerance = 1;
+  uint32_t tested = 0;
+  uint32_t differing = 0;
+  uint32_t failed = 0;
+  int16_t maxDiff = 0;
+
+  for(int16_t expo = -100; expo <= 100; expo++)
+  {
+    for(int16_t input = -500; input <= 500; input++)
+    {
+      int16_t ref = calcExpoReference(input, expo);
+      int16_t diff = abs(calcExpo(input, expo) - ref);
+      for(int16_t rate = 0; rate <= 100; rate++)
+      {
+        int16_t rateDiff = abs(calcRateExpo(input, rate, expo) - calcRateExpoReference(input, rate, expo));
+        if(rateDiff > diff)
+          diff = rateDiff;
+      }
+
+      tested++;
+      if(diff != 0)
+        differing++;
+      if(diff > maxDiff)
+        maxDiff = diff;
+      if(diff > tolerance)
+      {
+        if(failed < 10)
+          printf("FAIL calcExpo(%d, %d) = %d, reference %d\n", input, expo, calcExpo(input, expo), ref);
+        failed++;
+      }
+    }
+  }
+
+  printf("Expo               %u input and expo pairs, %u differ from the reference, max difference %d\n",
+         tested, differing, maxDiff);
+  return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,346 @@
+/*
+ * funcgen_test.cpp
+ *
+ * Checks generateWaveform() of the mtx mixer against the reference implementation,
+ * which worked out the time within the period with a modulo every frame. Each waveform
+ * is run for a minute of frames with a jittering frame time, with fixed and variable
+ * periods, fixed and compensated phase, and a resync halfway.
+ * With a fixed period, a sample passes if it is within 1 of the reference, the rounding of
+ * the firmware. With a variable period, it passes if it is within the tolerance of the
+ * reference samples of the frames before and after, as the edges may land a frame apart.
+ * The reference loses up to a millisecond at each period change, so the modulator moves in
+ * steps.
+ *
+ * Usage: funcgen_test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Arduino.h"
+
+#include "../config.h"
+#include "common.h"
+#include "mixer.h"
+
+int16_t generateWaveform(uint8_t idx, int32_t _currTime);
+
+//==================================================================================================
+//============================ Reference ===========================================================
+
+//As generateWaveform() was, with its state reset for each run
+static int32_t refOldPeriod[NUM_FUNCGEN];
+static int32_t refTimeOffset[NUM_FUNCGEN];
+static bool    refIsSync[NUM_FUNCGEN];
+static int32_t refPrevTimeInstance[NUM_FUNCGEN];
+static int16_t refModulatorValue[NUM_FUNCGEN];
+static bool    refIsExpired[NUM_FUNCGEN];
+static int16_t refLastResult[NUM_FUNCGEN];
+
+static int16_t generateWaveformReference(uint8_t idx, int32_t _currTime)
+{
+  int16_t result = 0;
+  
+  funcgen_t *fgen = &Model.Funcgen[idx];
+  
+  int32_t period;
+  if(fgen->waveform == FUNCGEN_WAVEFORM_PULSE)
+    period = (int32_t)fgen->period * 100;
+  else
+  {
+    if(fgen->periodMode == FUNCGEN_PERIODMODE_FIXED)
+      period = (int32_t)fgen->period1 * 100;
+    else
+    {
+      int32_t m = fgen->reverseModulator ? 0 - mixSources[fgen->modulatorSrc] : mixSources[fgen->modulatorSrc];
+      period = (((m + 500) * (fgen->period2 - fgen->period1)) / 10) + ((int32_t)fgen->period1 * 100);
+    }
+  }
+  
+  int32_t timeInstance = 0; 
+  
+  if(refIsSync[idx])
+  {
+    refIsSync[idx] = false;
+    refTimeOffset[idx] = 0;
+  }
+
+  bool phaseCompensate = false;
+  if(fgen->waveform == FUNCGEN_WAVEFORM_PULSE)
+  {
+    if(fgen->phaseMode == FUNCGEN_PHASEMODE_AUTO)
+      phaseCompensate = true;
+  }
+  else
+  {
+    if((fgen->periodMode == FUNCGEN_PERIODMODE_FIXED && fgen->phaseMode == FUNCGEN_PHASEMODE_AUTO) 
+      || fgen->periodMode == FUNCGEN_PERIODMODE_VARIABLE)
+      phaseCompensate = true;
+  }
+
+  if(phaseCompensate)
+  {
+    if(period != refOldPeriod[idx])
+    {
+      if(refOldPeriod[idx] == 0)
+      {
+        refTimeOffset[idx] = 0;
+        refOldPeriod[idx] = period; 
+      }
+      else
+      {
+        int32_t nextTimeInstance = (_currTime + refTimeOffset[idx]) % refOldPeriod[idx];
+        refTimeOffset[idx] = ((period * nextTimeInstance)/refOldPeriod[idx]) - (_currTime % period);
+        refOldPeriod[idx] = period; 
+      }
+    }
+    timeInstance = (_currTime + refTimeOffset[idx]) % period;
+  }
+  else
+  {
+    refTimeOffset[idx] = ((int32_t) fgen->phase * period) / 360;
+    if(_currTime >= refTimeOffset[idx])
+      timeInstance = (_currTime - refTimeOffset[idx]) % period;
+    else
+    {
+      timeInstance = period - ((refTimeOffset[idx] - _currTime) % period); 
+      timeInstance %= period;
+    }
+  }
+
+  switch(fgen->waveform)
+  {
+    case FUNCGEN_WAVEFORM_SINE:
+      {
+        static const int16_t sineTable[256] PROGMEM = {
+          0, 12, 25, 37, 49, 61, 73, 85, 98, 110, 121, 133, 145, 157, 168, 180,
+          191, 203, 214, 225, 236, 246, 257, 267, 278, 288, 298, 308, 317, 327, 336, 345,
+          354, 362, 370, 379, 387, 394, 402, 409, 416, 422, 429, 435, 441, 447, 452, 457,
+          462, 466, 471, 475, 478, 482, 485, 488, 490, 493, 495, 496, 498, 499, 499, 500,
+          500, 500, 499, 499, 498, 496, 495, 493, 490, 488, 485, 482, 478, 475, 471, 466,
+          462, 457, 452, 447, 441, 435, 429, 422, 416, 409, 402, 394, 387, 379, 370, 362,
+          354, 345, 336, 327, 317, 308, 298, 288, 278, 267, 257, 246, 236, 225, 214, 203,
+          191, 180, 168, 157, 145, 133, 121, 110, 98, 85, 73, 61, 49, 37, 25, 12,
+          0, -12, -25, -37, -49, -61, -73, -85, -98, -110, -121, -133, -145, -157, -168, -180,
+          -191, -203, -214, -225, -236, -246, -257, -267, -278, -288, -298, -308, -317, -327, -336, -345,
+          -354, -362, -370, -379, -387, -394, -402, -409, -416, -422, -429, -435, -441, -447, -452, -457,
+          -462, -466, -471, -475, -478, -482, -485, -488, -490, -493, -495, -496, -498, -499, -499, -500,
+          -500, -500, -499, -499, -498, -496, -495, -493, -490, -488, -485, -482, -478, -475, -471, -466,
+          -462, -457, -452, -447, -441, -435, -429, -422, -416, -409, -402, -394, -387, -379, -370, -362,
+          -354, -345, -336, -327, -317, -308, -298, -288, -278, -267, -257, -246, -236, -225, -214, -203,
+          -191, -180, -168, -157, -145, -133, -121, -110, -98, -85, -73, -61, -49, -37, -25, -12
+        };
+        const int16_t multiplier = 32;
+        int16_t index = (timeInstance * (sizeof(sineTable)/sizeof(sineTable[0])) * multiplier) / period; 
+        uint16_t indexLUT = index / multiplier;
+        int16_t valL = (int16_t)pgm_read_word(&sineTable[indexLUT]);
+        indexLUT++;
+        if(indexLUT >= (sizeof(sineTable)/sizeof(sineTable[0]))) 
+          indexLUT = 0;
+        int16_t valR = (int16_t)pgm_read_word(&sineTable[indexLUT]);
+        result = valL + (((valR - valL)*(index % multiplier)) / multiplier);
+      }
+      break;
+    
+    case FUNCGEN_WAVEFORM_SAWTOOTH:
+      if(timeInstance < (period/2))
+        result = map(timeInstance, 0, period/2, 0, 500);
+      else
+        result = map(timeInstance, period/2, period, -500, 0);
+      break;
+    
+    case FUNCGEN_WAVEFORM_TRIANGLE:
+      if(timeInstance < (period/4))
+        result = map(timeInstance, 0, period/4, 0, 500);
+      else if(timeInstance < ((3 * period)/4))
+        result = map(timeInstance, period/4, (3 * period)/4, 500, -500);
+      else
+        result = map(timeInstance, (3 * period)/4, period, -500, 0);
+      break;
+    
+    case FUNCGEN_WAVEFORM_SQUARE:
+      result = timeInstance < (period/2) ? 500 : -500;
+      break;
+
+    case FUNCGEN_WAVEFORM_PULSE:
+      if(fgen->widthMode == FUNCGEN_PULSE_WIDTH_FIXED)
+        result = (timeInstance < ((int32_t)fgen->width * 100)) ? 500 : -500;
+      else if(fgen->widthMode == FUNCGEN_PULSE_WIDTH_VARIABLE)
+      {
+        if(timeInstance < refPrevTimeInstance[idx])
+        {
+          refModulatorValue[idx] = mixSources[fgen->modulatorSrc];
+          if(fgen->reverseModulator)
+            refModulatorValue[idx] = 0 - refModulatorValue[idx];
+        }
+        refPrevTimeInstance[idx] = timeInstance;
+        int32_t highTime = ((refModulatorValue[idx] + 500) * period) / 1000;
+        result = (timeInstance < highTime) ? 500 : -500;
+      }
+      break;
+
+    case FUNCGEN_WAVEFORM_RANDOM:
+      if(timeInstance < (period/2) && refIsExpired[idx])
+      {
+        refIsExpired[idx] = false;
+        refLastResult[idx] = random(-500, 500);
+      }
+      if(timeInstance >= (period/2))
+        refIsExpired[idx] = true;
+      result = refLastResult[idx];
+      break;
+  }
+  
+  result = constrain(result, -500, 500);
+  return result;
+}
+
+//==================================================================================================
+
+#define NUM_FRAMES 3000
+
+typedef struct {
+  const char *name;
+  uint8_t  waveform;
+  uint8_t  mode;      //periodMode or widthMode
+  uint16_t period1;   //or width
+  uint16_t period2;   //or period
+  uint8_t  phaseMode;
+  uint16_t phase;
+} funcgen_case_t;
+
+static const funcgen_case_t cases[] = {
+  {"sine fixed",           FUNCGEN_WAVEFORM_SINE,     FUNCGEN_PERIODMODE_FIXED,    10, 10, FUNCGEN_PHASEMODE_AUTO,  0},
+  {"sine phase 90",        FUNCGEN_WAVEFORM_SINE,     FUNCGEN_PERIODMODE_FIXED,    13, 13, FUNCGEN_PHASEMODE_FIXED, 90},
+  {"sine variable",        FUNCGEN_WAVEFORM_SINE,     FUNCGEN_PERIODMODE_VARIABLE, 5,  40, FUNCGEN_PHASEMODE_AUTO,  0},
+  {"square fixed",         FUNCGEN_WAVEFORM_SQUARE,   FUNCGEN_PERIODMODE_FIXED,    7,  7,  FUNCGEN_PHASEMODE_AUTO,  0},
+  {"square phase 270",     FUNCGEN_WAVEFORM_SQUARE,   FUNCGEN_PERIODMODE_FIXED,    9,  9,  FUNCGEN_PHASEMODE_FIXED, 270},
+  {"square variable",      FUNCGEN_WAVEFORM_SQUARE,   FUNCGEN_PERIODMODE_VARIABLE, 2,  30, FUNCGEN_PHASEMODE_AUTO,  0},
+  {"triangle fixed",       FUNCGEN_WAVEFORM_TRIANGLE, FUNCGEN_PERIODMODE_FIXED,    25, 25, FUNCGEN_PHASEMODE_AUTO,  0},
+  {"triangle phase 45",    FUNCGEN_WAVEFORM_TRIANGLE, FUNCGEN_PERIODMODE_FIXED,    11, 11, FUNCGEN_PHASEMODE_FIXED, 45},
+  {"triangle variable",    FUNCGEN_WAVEFORM_TRIANGLE, FUNCGEN_PERIODMODE_VARIABLE, 10, 60, FUNCGEN_PHASEMODE_AUTO,  0},
+  {"sawtooth fixed",       FUNCGEN_WAVEFORM_SAWTOOTH, FUNCGEN_PERIODMODE_FIXED,    30, 30, FUNCGEN_PHASEMODE_AUTO,  0},
+  {"sawtooth phase 180",   FUNCGEN_WAVEFORM_SAWTOOTH, FUNCGEN_PERIODMODE_FIXED,    17, 17, FUNCGEN_PHASEMODE_FIXED, 180},
+  {"sawtooth variable",    FUNCGEN_WAVEFORM_SAWTOOTH, FUNCGEN_PERIODMODE_VARIABLE, 40, 8,  FUNCGEN_PHASEMODE_AUTO,  0},
+  {"pulse fixed width",    FUNCGEN_WAVEFORM_PULSE,    FUNCGEN_PULSE_WIDTH_FIXED,   3,  10, FUNCGEN_PHASEMODE_AUTO,  0},
+  {"pulse width > period", FUNCGEN_WAVEFORM_PULSE,    FUNCGEN_PULSE_WIDTH_FIXED,   12, 10, FUNCGEN_PHASEMODE_AUTO,  0},
+  {"pulse phase 120",      FUNCGEN_WAVEFORM_PULSE,    FUNCGEN_PULSE_WIDTH_FIXED,   5,  15, FUNCGEN_PHASEMODE_FIXED, 120},
+  {"pulse variable width", FUNCGEN_WAVEFORM_PULSE,    FUNCGEN_PULSE_WIDTH_VARIABLE,1,  20, FUNCGEN_PHASEMODE_AUTO,  0},
+  {"random fixed",         FUNCGEN_WAVEFORM_RANDOM,   FUNCGEN_PERIODMODE_FIXED,    6,  6,  FUNCGEN_PHASEMODE_AUTO,  0},
+  {"random phase 300",     FUNCGEN_WAVEFORM_RANDOM,   FUNCGEN_PERIODMODE_FIXED,    6,  6,  FUNCGEN_PHASEMODE_FIXED, 300},
+  {"random variable",      FUNCGEN_WAVEFORM_RANDOM,   FUNCGEN_PERIODMODE_VARIABLE, 3,  25, FUNCGEN_PHASEMODE_AUTO,  0},
+};
+
+static int32_t frameTime[NUM_FRAMES];
+static int16_t modulator[NUM_FRAMES];
+static int16_t refOut[NUM_FRAMES];
+static int16_t newOut[NUM_FRAMES];
+
+//Runs the frames through one implementation. The generator is resynced halfway.
+static void runFrames(uint8_t idx, bool isReference, int16_t *out)
+{
+  funcgen_t *fgen = &Model.Funcgen[idx];
+  randomSeed(idx + 1);
+  if(isReference)
+  {
+    refOldPeriod[idx] = 0;
+    refPrevTimeInstance[idx] = 0;
+    refModulatorValue[idx] = 0;
+    refIsExpired[idx] = false;
+    refLastResult[idx] = 0;
+  }
+  for(uint16_t i = 0; i < NUM_FRAMES; i++)
+  {
+    mixSources[fgen->modulatorSrc] = modulator[i];
+    if(i == NUM_FRAMES / 2 + 125) //not on a modulator step
+    {
+      if(isReference)
+        refIsSync[idx] = true;
+      else
+        syncWaveform(idx);
+    }
+    out[i] = isReference ? generateWaveformReference(idx, frameTime[i]) : generateWaveform(idx, frameTime[i]);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int16_t tolerance = 5;
+  uint32_t tested = 0;
+  uint32_t differing = 0;
+  uint32_t failed = 0;
+
+  //jittering frames from 10 to 30 ms, and a modulator stepping over its whole range every 5 s or so
+  srand(1);
+  int32_t t = 1234;
+  for(uint16_t i = 0; i < NUM_FRAMES; i++)
+  {
+    t += 10 + rand() % 21;
+    frameTime[i] = t;
+    int16_t m = ((i / 250) * 300) % 2000;
+    modulator[i] = (m < 1000) ? m - 500 : 1500 - m;
+  }
+
+  const uint8_t numCases = sizeof(cases) / sizeof(cases[0]);
+  for(uint8_t c = 0; c < numCases; c++)
+  {
+    //each case on a generator of its own, so the firmware starts from its initial state
+    uint8_t idx = c % NUM_FUNCGEN;
+    funcgen_t *fgen = &Model.Funcgen[idx];
+    fgen->waveform = cases[c].waveform;
+    fgen->periodMode = cases[c].mode;
+    fgen->period1 = cases[c].period1;
+    fgen->period2 = cases[c].period2;
+    fgen->modulatorSrc = SRC_X1_AXIS;
+    fgen->reverseModulator = (c % 2) != 0;
+    fgen->phaseMode = cases[c].phaseMode;
+    fgen->phase = cases[c].phase;
+
+    runFrames(idx, true, refOut);
+    syncWaveform(idx);
+    runFrames(idx, false, newOut);
+
+    bool isVariable;
+    if(cases[c].waveform == FUNCGEN_WAVEFORM_PULSE)
+      isVariable = (cases[c].mode == FUNCGEN_PULSE_WIDTH_VARIABLE);
+    else
+      isVariable = (cases[c].mode == FUNCGEN_PERIODMODE_VARIABLE);
+
+    uint32_t caseFailed = 0;
+    for(uint16_t i = 0; i < NUM_FRAMES; i++)
+    {
+      int16_t diff = abs(newOut[i] - refOut[i]);
+      if(diff != 0)
+        differing++;
+      bool isMatch = (diff <= 1);
+      if(isVariable)
+      {
+        int16_t lo = refOut[i];
+        int16_t hi = refOut[i];
+        for(uint16_t j = (i > 0) ? i - 1 : i; j <= i + 1 && j < NUM_FRAMES; j++)
+        {
+          if(refOut[j] < lo)
+            lo = refOut[j];
+          if(refOut[j] > hi)
+            hi = refOut[j];
+        }
+        isMatch = newOut[i] >= lo - tolerance && newOut[i] <= hi + tolerance;
+        //the sawtooth may be either side of its jump from 500 to -500
+        if(abs(newOut[i]) >= 500 - tolerance && abs(refOut[i]) >= 500 - tolerance)
+          isMatch = true;
+      }
+      if(!isMatch)
+      {
+        if(caseFailed < 5)
+          printf("FAIL %s, frame %u at %d ms: %d, reference %d\n", cases[c].name, i, frameTime[i], newOut[i], refOut[i]);
+        caseFailed++;
+      }
+      tested++;
+    }
+    failed += caseFailed;
+  }
+
+  printf("Funcgen            %u samples, %u differ from the reference, %u out of tolerance\n",
+         tested, differing, failed);
+  return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,325 @@
+/*
+ * lcd_bench.cpp
+ *
+ * Counts the LCD bus transactions per frame of the KS0108 and ST7920 drivers on a few
+ * typical screens, drawn the way the UI does it: clear the frame buffer, draw everything,
+ * then flush. A transaction is one command or data byte strobed into the LCD.
+ *
+ * The "whole frame" line is the first flush after begin(), which sends everything. That is
+ * what every frame cost before the drivers tracked the changes.
+ *
+ * The estimated time on the ATmega2560 adds up the EN strobe delays of each transaction
+ * (about 90 cycles for the KS0108, 220 for the ST7920, at 16 MHz) and, for the ST7920, the
+ * fixed delays around each GDRAM address set.
+ *
+ * It also times the rendering of a full menu page into the frame buffer, drawing the text one
+ * character at a time as before drawText(), in runs, and in runs with the header kept as a
+ * static layer from one frame to the next.
+ *
+ * Usage: lcd_bench [--frames n]
+ *   --frames n    frames per screen (default 500)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Arduino.h"
+#include "HostHAL.h"
+
+#include "../config.h"
+#include "lcd/GFX.h"
+#include "lcd/LCDKS0108.h"
+#include "lcd/LCDST7920.h"
+
+#define KS0108_US_PER_TRANSACTION  5.6
+#define ST7920_US_PER_TRANSACTION  13.8
+
+//==================================================================================================
+//============================ Screens =============================================================
+
+//Header bar with the title in inverted text, as drawHeader() does
+static void drawHeader(GFX &lcd, const char *title)
+{
+  lcd.fillRect(0, 0, 128, 8, BLACK);
+  lcd.setTextColor(WHITE);
+  lcd.setCursor(1, 0);
+  lcd.print(title);
+  lcd.setTextColor(BLACK);
+}
+
+//Model name, battery, two timers counting seconds and the trim bars
+static void screenHome(GFX &lcd, uint32_t frame)
+{
+  lcd.setCursor(0, 0);
+  lcd.print("Plane 1");
+  lcd.drawRect(108, 0, 18, 7, BLACK);
+  lcd.fillRect(110, 2, 12, 3, BLACK);
+  lcd.drawHLine(0, 9, 128, BLACK);
+
+  uint32_t secs = frame / 50;
+  char buff[16];
+  snprintf(buff, sizeof(buff), "%02u:%02u", (unsigned)(secs / 60), (unsigned)(secs % 60));
+  lcd.setCursor(40, 20);
+  lcd.print(buff);
+  snprintf(buff, sizeof(buff), "T2 %02u:%02u", (unsigned)((secs + 75) / 60), (unsigned)((secs + 75) % 60));
+  lcd.setCursor(40, 30);
+  lcd.print(buff);
+
+  lcd.drawRect(10, 58, 47, 5, BLACK);
+  lcd.drawVLine(33 + (int8_t)(frame / 100 % 7) - 3, 57, 7, BLACK);
+  lcd.drawRect(71, 58, 47, 5, BLACK);
+  lcd.drawVLine(94, 57, 7, BLACK);
+}
+
+//Six item list with the cursor moving every half second, as in the main menu
+static void screenMenu(GFX &lcd, uint32_t frame)
+{
+  static const char *items[] = {"Model", "Inputs", "Mixer", "Outputs", "Timers", "Telemetry"};
+  drawHeader(lcd, "Main menu");
+  uint8_t focused = (frame / 25) % 6;
+  for(uint8_t line = 0; line < 6; line++)
+  {
+    uint8_t ypos = 9 + line * 9;
+    if(line == focused)
+      lcd.fillRect(0, ypos - 1, 6, 9, BLACK);
+    lcd.setCursor(8, ypos);
+    lcd.print(items[line]);
+  }
+  lcd.fillRect(127, 9 + focused * 9, 1, 9, BLACK);
+}
+
+//Eight channel bars moving every frame, as in the outputs monitor
+static void screenMonitor(GFX &lcd, uint32_t frame)
+{
+  drawHeader(lcd, "Outputs");
+  for(uint8_t ch = 0; ch < 8; ch++)
+  {
+    uint8_t ypos = 10 + ch * 7;
+    lcd.setCursor(0, ypos);
+    lcd.print("Ch");
+    lcd.print(ch + 1);
+    lcd.drawRect(24, ypos, 100, 5, BLACK);
+    int8_t w = (int8_t)(48 * sin((frame + ch * 20) * 0.05));
+    if(w > 0)
+      lcd.fillRect(74, ypos + 1, w, 3, BLACK);
+    else if(w < 0)
+      lcd.fillRect(74 + w, ypos + 1, -w, 3, BLACK);
+  }
+}
+
+//A full screen message that does not change
+static void screenMessage(GFX &lcd, uint32_t frame)
+{
+  lcd.setCursor(34, 24);
+  lcd.print("Please wait");
+}
+
+typedef struct {
+  const char *name;
+  void (*draw)(GFX &lcd, uint32_t frame);
+} screen_t;
+
+static const screen_t screens[] = {
+  {"home",    screenHome},
+  {"menu",    screenMenu},
+  {"monitor", screenMonitor},
+  {"message", screenMessage},
+};
+
+#define NUM_SCREENS (sizeof(screens) / sizeof(screens[0]))
+
+//==================================================================================================
+//============================ Bench ===============================================================
+
+typedef struct {
+  double transactions; //per frame
+  double delayMicros;  //fixed delays per frame
+} result_t;
+
+template <class LCD>
+static result_t measureFlush(LCD &lcd)
+{
+  uint32_t writes = PORTx_LCD_DATA.writeCount;
+  uint64_t time = hostTimeMicros;
+  lcd.display();
+  result_t r;
+  r.transactions = PORTx_LCD_DATA.writeCount - writes;
+  r.delayMicros = hostTimeMicros - time;
+  return r;
+}
+
+//The whole frame, then the average over the frames of each screen. Flushed progressively,
+//so everything drawn in a frame is counted in that frame.
+template <class LCD>
+static void runDriver(LCD &lcd, result_t *wholeFrame, result_t *perScreen, uint32_t frames)
+{
+  lcd.begin();
+  lcd.setInterlace(false);
+  screens[0].draw(lcd, 0);
+  *wholeFrame = measureFlush(lcd);
+  lcd.clearDisplay();
+
+  for(uint8_t s = 0; s < NUM_SCREENS; s++)
+  {
+    result_t sum = {0, 0};
+    for(uint32_t f = 0; f < frames; f++)
+    {
+      screens[s].draw(lcd, f);
+      result_t r = measureFlush(lcd);
+      lcd.clearDisplay();
+      sum.transactions += r.transactions;
+      sum.delayMicros += r.delayMicros;
+    }
+    perScreen[s].transactions = sum.transactions / frames;
+    perScreen[s].delayMicros = sum.delayMicros / frames;
+  }
+}
+
+//==================================================================================================
+//============================ Render timing =======================================================
+
+static inline uint64_t readCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+//Prints the text either as a run, or one character at a time as the AVR core prints a
+//flash string and as every string was drawn before the drivers had drawText()
+static void printText(GFX &lcd, const char *str, bool perChar)
+{
+  if(!perChar)
+  {
+    lcd.print(str);
+    return;
+  }
+  while(*str)
+    lcd.write((uint8_t) *str++);
+}
+
+enum {
+  RENDER_PER_CHAR,
+  RENDER_TEXT_RUNS,
+  RENDER_KEPT_HEADER, //text runs, with the header kept as a static layer
+};
+
+//A full menu page: the header and six lines of a label and a value, as in the model settings
+static void renderMenuPage(GFX &lcd, bool perChar, bool hasHeader)
+{
+  static const char *labels[] = {"Name:", "Type:", "Rud mix:", "Thr cut:", "Idle up:", "Timer 1:"};
+  static const char *values[] = {"Plane 1", "Airplane", "Off", "On", "Disabled", "05:00"};
+  if(hasHeader)
+  {
+    lcd.fillRect(0, 0, 128, 8, BLACK);
+    lcd.setTextColor(WHITE);
+    lcd.setCursor(1, 0);
+    printText(lcd, "Model setup", perChar);
+    lcd.setTextColor(BLACK);
+  }
+  for(uint8_t line = 0; line < 6; line++)
+  {
+    uint8_t ypos = 10 + line * 9;
+    lcd.setCursor(0, ypos);
+    printText(lcd, labels[line], perChar);
+    lcd.setCursor(60, ypos);
+    printText(lcd, values[line], perChar);
+  }
+}
+
+//Median host cycles (or ns) to clear the frame buffer and render the page
+template <class LCD>
+static uint64_t timeMenuPage(LCD &lcd, uint8_t mode, uint32_t pages)
+{
+  std::vector<uint64_t> samples;
+  samples.reserve(pages);
+  lcd.clearDisplay();
+  for(uint32_t i = 0; i < pages; i++)
+  {
+    uint64_t start = readCycles();
+    if(mode == RENDER_KEPT_HEADER)
+    {
+      lcd.clearDynamicLayer();
+      bool isKept = lcd.getStaticLayer() & 0x01;
+      renderMenuPage(lcd, false, !isKept);
+      lcd.setStaticLayer(0x01);
+    }
+    else
+    {
+      lcd.clearDisplay();
+      renderMenuPage(lcd, mode == RENDER_PER_CHAR, true);
+    }
+    samples.push_back(readCycles() - start);
+  }
+  lcd.clearDisplay();
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+//--------------------------------------------------------------------------------------------------
+
+static LCDKS0108 ks0108 = LCDKS0108(PIN_KS_RS, PIN_KS_EN, PIN_KS_CS1, PIN_KS_CS2);
+static LCDST7920 st7920 = LCDST7920(PIN_ST_RS, PIN_ST_EN);
+
+static void printLine(const char *name, const result_t *ks, const result_t *st)
+{
+  printf("  %-12s %8.1f %8.2f   %8.1f %8.2f\n", name,
+         ks->transactions, ks->transactions * KS0108_US_PER_TRANSACTION / 1000,
+         st->transactions, (st->transactions * ST7920_US_PER_TRANSACTION + st->delayMicros) / 1000);
+}
+
+int main(int argc, char* argv[])
+{
+  uint32_t frames = 500;
+
+  for(int i = 1; i < argc; i++)
+  {
+    if(strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+      frames = strtoul(argv[++i], NULL, 10);
+    else
+    {
+      fprintf(stderr, "Usage: %s [--frames n]\n", argv[0]);
+      return 2;
+    }
+  }
+  if(frames == 0)
+    frames = 1;
+
+  hostResetHardware();
+
+  result_t ksWhole, stWhole;
+  result_t ksScreens[NUM_SCREENS], stScreens[NUM_SCREENS];
+  runDriver(ks0108, &ksWhole, ksScreens, frames);
+  runDriver(st7920, &stWhole, stScreens, frames);
+
+  printf("LCD flush, %u frames per screen, bus transactions and estimated ms per frame\n", frames);
+  printf("  %-12s %17s   %17s\n", "", "KS0108", "ST7920");
+  printf("  %-12s %8s %8s   %8s %8s\n", "", "trans", "ms", "trans", "ms");
+  printLine("whole frame", &ksWhole, &stWhole);
+  for(uint8_t s = 0; s < NUM_SCREENS; s++)
+    printLine(screens[s].name, &ksScreens[s], &stScreens[s]);
+
+  printf("\nMenu page render, %u pages, median host cycles per page\n", frames);
+  printf("  %-12s %8s %8s\n", "", "KS0108", "ST7920");
+  printf("  %-12s %8llu %8llu\n", "per char",
+         (unsigned long long) timeMenuPage(ks0108, RENDER_PER_CHAR, frames),
+         (unsigned long long) timeMenuPage(st7920, RENDER_PER_CHAR, frames));
+  printf("  %-12s %8llu %8llu\n", "text runs",
+         (unsigned long long) timeMenuPage(ks0108, RENDER_TEXT_RUNS, frames),
+         (unsigned long long) timeMenuPage(st7920, RENDER_TEXT_RUNS, frames));
+  printf("  %-12s %8llu %8llu\n", "kept header",
+         (unsigned long long) timeMenuPage(ks0108, RENDER_KEPT_HEADER, frames),
+         (unsigned long long) timeMenuPage(st7920, RENDER_KEPT_HEADER, frames));
+  return 0;
+}
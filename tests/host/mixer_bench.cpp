@@ -0,0 +1,458 @@
+/*
+ * mixer_bench.cpp
+ *
+ * Micro-benchmarks of the mtx mixer on a set of model fixtures, from an empty model
+ * up to one that uses every mixer slot, logical switch, function generator and counter.
+ * Each iteration is one 20 ms frame of virtual time with moving sticks and switches,
+ * and the mixer functions are timed separately in host CPU cycles.
+ *
+ * The cycle counts are those of the host CPU, not of the ATmega2560. They are for
+ * comparing fixtures and changes to the mixer, not for predicting the time on target.
+ *
+ * The custom curves are also timed on their own, evaluated the way the mixer used to do it
+ * (points scaled on every call, tangents worked out with divisions) and from the curve cache.
+ *
+ * Usage: mixer_bench [options]
+ *   --iterations n    frames per fixture (default 5000)
+ *   --fixture name    only run the named fixture, or "curves"
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Arduino.h"
+#include "HostHAL.h"
+
+#include "../config.h"
+#include "common.h"
+#include "mathHelpers.h"
+#include "mixer.h"
+#include "templates.h"
+
+//not in mixer.h, only used by computeChannelOutputs()
+int16_t generateWaveform(uint8_t idx, int32_t _currTime);
+void evaluateLogicalSwitches(uint32_t _currTime);
+void evaluateCounters();
+int16_t evaluateCurve(uint8_t crvIdx, int16_t xVal);
+
+//==================================================================================================
+//============================ Fixtures ============================================================
+
+static void fixtureEmpty()
+{
+  resetModelParams();
+}
+
+//The basic airplane template, with dual rates, a timer on the throttle and a flaps mix
+static void fixturePlane()
+{
+  resetModelParams();
+  loadMixerTemplateBasic(0);
+
+  Model.AilDualRate.rate2 = 70;
+  Model.AilDualRate.expo1 = 20;
+  Model.AilDualRate.expo2 = 30;
+  Model.AilDualRate.swtch = CTRL_SW_PHYSICAL_FIRST + 6 * 1 + 2; //SWB down
+  Model.EleDualRate = Model.AilDualRate;
+
+  Model.LogicalSwitch[0].func = LS_FUNC_A_GREATER_THAN_X;
+  Model.LogicalSwitch[0].val1 = SRC_THR;
+  Model.LogicalSwitch[0].val2 = -95;
+  Model.Timer[0].swtch = CTRL_SW_LOGICAL_FIRST;
+
+  Model.Mixer[4].output = SRC_CH1 + 4;
+  Model.Mixer[4].input = SRC_SW_PHYSICAL_FIRST + 2;
+  Model.Mixer[4].slowUp = 20;
+  Model.Mixer[4].slowDown = 20;
+}
+
+//Every feature in use, with the costly options: smoothed curves with the most points,
+//delay and slow on all mixes, a control switch on most of them
+static void fixtureWorstCase()
+{
+  resetModelParams();
+
+  Model.ThrottleCurve.numPoints = MAX_NUM_POINTS_CUSTOM_CURVE;
+  Model.ThrottleCurve.smooth = true;
+  for(uint8_t pt = 0; pt < MAX_NUM_POINTS_CUSTOM_CURVE; pt++)
+  {
+    Model.ThrottleCurve.xVal[pt] = -100 + (200 * pt) / (MAX_NUM_POINTS_CUSTOM_CURVE - 1);
+    Model.ThrottleCurve.yVal[pt] = -100 + (200 * pt * pt) / ((MAX_NUM_POINTS_CUSTOM_CURVE - 1) * (MAX_NUM_POINTS_CUSTOM_CURVE - 1));
+  }
+  for(uint8_t i = 0; i < NUM_CUSTOM_CURVES; i++)
+  {
+    Model.CustomCurve[i] = Model.ThrottleCurve;
+    Model.CustomCurve[i].yVal[i] = 0;
+  }
+
+  rate_expo_t* rateExpo[3] = {&Model.RudDualRate, &Model.AilDualRate, &Model.EleDualRate};
+  for(uint8_t i = 0; i < 3; i++)
+  {
+    rateExpo[i]->rate2 = 60;
+    rateExpo[i]->expo1 = 25;
+    rateExpo[i]->expo2 = 40;
+    rateExpo[i]->swtch = CTRL_SW_PHYSICAL_FIRST + 6 * i + 2;
+  }
+
+  for(uint8_t i = 1; i < NUM_FLIGHT_MODES; i++)
+  {
+    Model.FlightMode[i].swtch = CTRL_SW_PHYSICAL_FIRST + 6 * 3 + (i - 1); //SWD up, mid, down, !up
+    Model.FlightMode[i].x2Trim = 10 * i;
+  }
+
+  static const uint8_t waveforms[NUM_FUNCGEN] = {
+    FUNCGEN_WAVEFORM_SINE, FUNCGEN_WAVEFORM_TRIANGLE, FUNCGEN_WAVEFORM_SAWTOOTH,
+    FUNCGEN_WAVEFORM_PULSE, FUNCGEN_WAVEFORM_RANDOM
+  };
+  for(uint8_t i = 0; i < NUM_FUNCGEN; i++)
+  {
+    Model.Funcgen[i].waveform = waveforms[i];
+    Model.Funcgen[i].periodMode = FUNCGEN_PERIODMODE_VARIABLE;
+    Model.Funcgen[i].period1 = 5;
+    Model.Funcgen[i].period2 = 30;
+    Model.Funcgen[i].modulatorSrc = SRC_KNOB_FIRST;
+  }
+
+  //all the function groups, most with a delay and a duration
+  static const uint8_t lsFuncs[] = {
+    LS_FUNC_A_GREATER_THAN_X, LS_FUNC_ABS_A_LESS_THAN_X, LS_FUNC_ABS_DELTA_GREATER_THAN_X,
+    LS_FUNC_A_GREATER_THAN_B, LS_FUNC_AND, LS_FUNC_OR, LS_FUNC_XOR, LS_FUNC_LATCH,
+    LS_FUNC_TOGGLE, LS_FUNC_PULSE
+  };
+  for(uint8_t i = 0; i < NUM_LOGICAL_SWITCHES; i++)
+  {
+    logical_switch_t *ls = &Model.LogicalSwitch[i];
+    ls->func = lsFuncs[i % sizeof(lsFuncs)];
+    switch(ls->func)
+    {
+      case LS_FUNC_A_GREATER_THAN_B:
+        ls->val1 = SRC_AIL;
+        ls->val2 = SRC_FUNCGEN_FIRST + (i % NUM_FUNCGEN);
+        break;
+      case LS_FUNC_AND:
+      case LS_FUNC_OR:
+      case LS_FUNC_XOR:
+      case LS_FUNC_LATCH:
+        //only refer to earlier switches, so the result settles in one pass
+        ls->val1 = CTRL_SW_LOGICAL_FIRST + i - 3;
+        ls->val2 = CTRL_SW_PHYSICAL_FIRST + 6 * (i % NUM_PHYSICAL_SWITCHES);
+        break;
+      case LS_FUNC_TOGGLE:
+        ls->val1 = CTRL_SW_LOGICAL_FIRST + i - 1;
+        ls->val2 = 2;
+        ls->val3 = CTRL_SW_NONE;
+        break;
+      case LS_FUNC_PULSE:
+        ls->val1 = 2;
+        ls->val2 = 5 + i;
+        ls->val3 = 1;
+        break;
+      default:
+        ls->val1 = SRC_STICK_AXIS_FIRST + (i % NUM_STICK_AXES);
+        ls->val2 = 20;
+        ls->val3 = (ls->func == LS_FUNC_ABS_DELTA_GREATER_THAN_X) ? 2 : 3;
+        ls->val4 = 10;
+        break;
+    }
+  }
+
+  for(uint8_t i = 0; i < NUM_COUNTERS; i++)
+  {
+    Model.Counter[i].type = (i % 2) ? COUNTER_TYPE_ADVANCED : COUNTER_TYPE_BASIC;
+    Model.Counter[i].clock = CTRL_SW_LOGICAL_FIRST + 9 + i;
+    Model.Counter[i].decrementClock = CTRL_SW_LOGICAL_FIRST + 10 + i;
+    Model.Counter[i].edge = 2;
+    Model.Counter[i].decrementEdge = 1;
+    Model.Counter[i].clear = CTRL_SW_PHYSICAL_FIRST + 6 * 7 + 2; //SWH down
+    Model.Counter[i].modulus = 100;
+  }
+
+  //40 mixes spread over the channels and virtual channels, each of them with
+  //delay and slow, cycling through the operations and curve types
+  static const uint8_t mixInputs[] = {
+    SRC_AIL, SRC_ELE, SRC_THR, SRC_RUD, SRC_FUNCGEN_FIRST, SRC_KNOB_FIRST,
+    SRC_SW_LOGICAL_FIRST + 4, SRC_VIRTUAL_FIRST, SRC_COUNTER_FIRST, SRC_Z1_AXIS
+  };
+  for(uint8_t i = 0; i < NUM_MIX_SLOTS; i++)
+  {
+    mixer_params_t *mxr = &Model.Mixer[i];
+    mxr->output = (i < 5) ? SRC_VIRTUAL_FIRST + i : SRC_CH1 + (i % NUM_RC_CHANNELS);
+    mxr->input = mixInputs[i % sizeof(mixInputs)];
+    mxr->operation = (i % 7 == 6) ? MIX_MULTIPLY : ((i % 11 == 10) ? MIX_REPLACE : MIX_ADD);
+    mxr->swtch = (i % 4 == 0) ? CTRL_SW_NONE : CTRL_SW_LOGICAL_FIRST + (i % NUM_LOGICAL_SWITCHES);
+    mxr->weight = 80;
+    mxr->offset = 5;
+    mxr->curveType = i % MIX_CURVE_TYPE_COUNT;
+    switch(mxr->curveType)
+    {
+      case MIX_CURVE_TYPE_DIFF:     mxr->curveVal = 30; break;
+      case MIX_CURVE_TYPE_EXPO:     mxr->curveVal = 40; break;
+      case MIX_CURVE_TYPE_FUNCTION: mxr->curveVal = MIX_CURVE_FUNC_ABS_X; break;
+      case MIX_CURVE_TYPE_CUSTOM:   mxr->curveVal = i % NUM_CUSTOM_CURVES; break;
+    }
+    mxr->delayUp = 3;
+    mxr->delayDown = 2;
+    mxr->slowUp = 10;
+    mxr->slowDown = 15;
+  }
+
+  for(uint8_t i = 0; i < NUM_RC_CHANNELS; i++)
+  {
+    Model.Channel[i].curve = i % NUM_CUSTOM_CURVES;
+    Model.Channel[i].subtrim = 5;
+    Model.Channel[i].overrideSwitch = CTRL_SW_LOGICAL_FIRST_INVERT + i;
+  }
+}
+
+typedef struct {
+  const char *name;
+  void (*load)();
+} fixture_t;
+
+static const fixture_t fixtures[] = {
+  {"empty", fixtureEmpty},
+  {"plane", fixturePlane},
+  {"worst-case", fixtureWorstCase},
+};
+
+#define NUM_FIXTURES (sizeof(fixtures) / sizeof(fixtures[0]))
+
+//==================================================================================================
+//============================ Timing ==============================================================
+
+static inline uint64_t readCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static void printSamples(const char *name, std::vector<uint64_t> &s)
+{
+  std::sort(s.begin(), s.end());
+  printf("  %-24s %8llu %8llu %8llu %8llu\n", name,
+         (unsigned long long) s.front(), (unsigned long long) s[s.size() / 2],
+         (unsigned long long) s[(s.size() * 99) / 100], (unsigned long long) s.back());
+}
+
+enum {
+  BENCH_COMPUTE_CHANNEL_OUTPUTS,
+  BENCH_EVALUATE_LOGICAL_SWITCHES,
+  BENCH_EVALUATE_COUNTERS,
+  BENCH_GENERATE_WAVEFORM,
+
+  BENCH_COUNT
+};
+
+static const char* benchNames[BENCH_COUNT] = {
+  "computeChannelOutputs",
+  "evaluateLogicalSwitches",
+  "evaluateCounters",
+  "generateWaveform x5",
+};
+
+static std::vector<uint64_t> samples[BENCH_COUNT];
+
+//FNV-1a hash of the channel outputs of every frame. Changes to the mixer that are meant
+//to be optimisations only must leave it unchanged.
+static uint32_t outputHash;
+
+//Sticks sweep back and forth at different rates and switches flip now and then,
+//so that delays, slows, edges and curve segments all get exercised
+static void moveInputs(uint32_t frame)
+{
+  for(uint8_t i = 0; i < NUM_STICK_AXES; i++)
+  {
+    int32_t phase = (frame * (3 + i) * 4) % 2000;
+    stickAxisIn[i] = (phase < 1000) ? phase - 500 : 1500 - phase;
+  }
+  for(uint8_t i = 0; i < NUM_KNOBS; i++)
+    knobIn[i] = ((frame * 7 + i * 250) % 1000) - 500;
+  for(uint8_t i = 0; i < NUM_PHYSICAL_SWITCHES; i++)
+    swState[i] = ((frame / (25 + 10 * i)) % 3 == 0) ? SWUPPERPOS : (((frame / (25 + 10 * i)) % 3 == 1) ? SWMIDPOS : SWLOWERPOS);
+}
+
+static void runFixture(const fixture_t *fixture, uint32_t iterations)
+{
+  fixture->load();
+  reinitialiseMixerCalculations();
+  updateCurveCache();
+  moveInputs(0);
+  computeChannelOutputs();
+
+  for(uint8_t b = 0; b < BENCH_COUNT; b++)
+  {
+    samples[b].clear();
+    samples[b].reserve(iterations);
+  }
+  outputHash = 2166136261UL;
+
+  for(uint32_t frame = 1; frame <= iterations; frame++)
+  {
+    hostAdvanceTime(fixedLoopTime * 1000UL);
+    moveInputs(frame);
+
+    uint64_t t0 = readCycles();
+    computeChannelOutputs();
+    uint64_t t1 = readCycles();
+    samples[BENCH_COMPUTE_CHANNEL_OUTPUTS].push_back(t1 - t0);
+    for(uint8_t i = 0; i < NUM_RC_CHANNELS; i++)
+      outputHash = (outputHash ^ (uint16_t) channelOut[i]) * 16777619UL;
+
+    //the parts, timed again on the state left by this frame
+    uint32_t currMillis = millis();
+    t0 = readCycles();
+    evaluateLogicalSwitches(currMillis);
+    t1 = readCycles();
+    samples[BENCH_EVALUATE_LOGICAL_SWITCHES].push_back(t1 - t0);
+
+    t0 = readCycles();
+    evaluateCounters();
+    t1 = readCycles();
+    samples[BENCH_EVALUATE_COUNTERS].push_back(t1 - t0);
+
+    t0 = readCycles();
+    for(uint8_t i = 0; i < NUM_FUNCGEN; i++)
+      mixSources[SRC_FUNCGEN_FIRST + i] = generateWaveform(i, currMillis);
+    t1 = readCycles();
+    samples[BENCH_GENERATE_WAVEFORM].push_back(t1 - t0);
+  }
+
+  printf("%s (outputs %08x)\n", fixture->name, outputHash);
+  for(uint8_t b = 0; b < BENCH_COUNT; b++)
+    printSamples(benchNames[b], samples[b]);
+}
+
+//==================================================================================================
+//============================ Curves ==============================================================
+
+//As computeChannelOutputs() did before the curve cache
+static int16_t evaluateCurveUncached(custom_curve_t *crv, int16_t xVal)
+{
+  int16_t _xx[MAX_NUM_POINTS_CUSTOM_CURVE];
+  int16_t _yy[MAX_NUM_POINTS_CUSTOM_CURVE];
+  for(uint8_t pt = 0; pt < crv->numPoints; pt++)
+  {
+    _xx[pt] = 5 * crv->xVal[pt];
+    _yy[pt] = 5 * crv->yVal[pt];
+  }
+  if(crv->smooth)
+    return cubicHermiteInterpolate(_xx, _yy, crv->numPoints, xVal);
+  else
+    return linearInterpolate(_xx, _yy, crv->numPoints, xVal);
+}
+
+//The smoothed 10 point custom curves of the worst case fixture, each evaluated over the
+//whole input range, then again as linear curves. Both ways must give the same outputs.
+static bool runCurves(uint32_t iterations)
+{
+  fixtureWorstCase();
+  
+  uint32_t mismatches = 0;
+  static const bool smoothModes[2] = {true, false};
+  for(uint8_t m = 0; m < 2; m++)
+  {
+    bool smooth = smoothModes[m];
+    for(uint8_t i = 0; i < NUM_CUSTOM_CURVES; i++)
+      Model.CustomCurve[i].smooth = smooth;
+    reinitialiseMixerCalculations();
+    updateCurveCache();
+    moveInputs(0);
+    computeChannelOutputs();
+    
+    std::vector<uint64_t> uncached, cached;
+    uncached.reserve(iterations);
+    cached.reserve(iterations);
+    for(uint32_t n = 0; n < iterations; n++)
+    {
+      uint8_t crvIdx = n % NUM_CUSTOM_CURVES;
+      int16_t x = (int16_t)((n * 7) % 1041) - 520;
+      
+      uint64_t t0 = readCycles();
+      int16_t yUncached = evaluateCurveUncached(&Model.CustomCurve[crvIdx], x);
+      uint64_t t1 = readCycles();
+      uncached.push_back(t1 - t0);
+      
+      t0 = readCycles();
+      int16_t yCached = evaluateCurve(crvIdx, x);
+      t1 = readCycles();
+      cached.push_back(t1 - t0);
+      
+      if(yCached != yUncached)
+        mismatches++;
+    }
+    
+    printf("curves, %s 10 points\n", smooth ? "smoothed" : "linear");
+    printSamples("uncached", uncached);
+    printSamples("cached", cached);
+  }
+  
+  printf("curves: %u mismatches\n", mismatches);
+  return mismatches == 0;
+}
+
+//==================================================================================================
+
+int main(int argc, char* argv[])
+{
+  uint32_t iterations = 5000;
+  const char *only = NULL;
+
+  for(int i = 1; i < argc; i++)
+  {
+    if(strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+      iterations = strtoul(argv[++i], NULL, 10);
+    else if(strcmp(argv[i], "--fixture") == 0 && i + 1 < argc)
+      only = argv[++i];
+    else
+    {
+      fprintf(stderr, "Usage: %s [--iterations n] [--fixture name]\n", argv[0]);
+      return 2;
+    }
+  }
+  if(iterations == 0)
+    iterations = 1;
+
+  hostResetHardware();
+  hostEraseEeproms();
+  resetSystemParams();
+
+#if defined(__x86_64__) || defined(__i386__)
+  const char *unit = "host cycles";
+#else
+  const char *unit = "ns";
+#endif
+  printf("Mixer benchmarks, %u frames per fixture, in %s\n", iterations, unit);
+  printf("  %-24s %8s %8s %8s %8s\n", "", "min", "median", "p99", "max");
+
+  bool found = false;
+  for(uint8_t f = 0; f < NUM_FIXTURES; f++)
+  {
+    if(only != NULL && strcmp(only, fixtures[f].name) != 0)
+      continue;
+    runFixture(&fixtures[f], iterations);
+    found = true;
+  }
+  if(only == NULL || strcmp(only, "curves") == 0)
+  {
+    if(!runCurves(iterations))
+      return 1;
+    found = true;
+  }
+  if(!found)
+  {
+    fprintf(stderr, "No fixture named %s\n", only);
+    return 2;
+  }
+  return 0;
+}
@@ -0,0 +1,116 @@
+#include <string.h>
+#include <strings.h>
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "HostHAL.h"
+
+#include "../config.h"
+#include "common.h"
+#include "crc.h"
+#include "mtx_board.h"
+
+const input_def_t inputDefs[MTX_NUM_INPUTS] = {
+  {"X1", INPUT_KIND_ANALOG, PIN_X1_AXIS, 0},
+  {"Y1", INPUT_KIND_ANALOG, PIN_Y1_AXIS, 0},
+  {"Z1", INPUT_KIND_ANALOG, PIN_Z1_AXIS, 0},
+  {"X2", INPUT_KIND_ANALOG, PIN_X2_AXIS, 0},
+  {"Y2", INPUT_KIND_ANALOG, PIN_Y2_AXIS, 0},
+  {"Z2", INPUT_KIND_ANALOG, PIN_Z2_AXIS, 0},
+  {"X3", INPUT_KIND_ANALOG, PIN_X3_AXIS, 0},
+  {"Y3", INPUT_KIND_ANALOG, PIN_Y3_AXIS, 0},
+  {"X4", INPUT_KIND_ANALOG, PIN_X4_AXIS, 0},
+  {"Y4", INPUT_KIND_ANALOG, PIN_Y4_AXIS, 0},
+  {"KNOBA", INPUT_KIND_ANALOG, PIN_KNOB_A, 0},
+  {"KNOBB", INPUT_KIND_ANALOG, PIN_KNOB_B, 0},
+  {"BATT",  INPUT_KIND_ANALOG, PIN_BATTERY_VOLTS, 0},
+  {"SWA", INPUT_KIND_SWITCH, PIN_SWA_UP, PIN_SWA_DN},
+  {"SWB", INPUT_KIND_SWITCH, PIN_SWB_UP, PIN_SWB_DN},
+  {"SWC", INPUT_KIND_SWITCH, PIN_SWC_UP, PIN_SWC_DN},
+  {"SWD", INPUT_KIND_SWITCH, PIN_SWD_UP, PIN_SWD_DN},
+  {"SWE", INPUT_KIND_SWITCH, PIN_SWE_UP, PIN_SWE_DN},
+  {"SWF", INPUT_KIND_SWITCH, PIN_SWF_UP, PIN_SWF_DN},
+  {"SWG", INPUT_KIND_SWITCH, PIN_SWG_UP, PIN_SWG_DN},
+  {"SWH", INPUT_KIND_SWITCH, PIN_SWH_UP, PIN_SWH_DN},
+  {"SELECT", INPUT_KIND_KEY, PIN_KEY_SELECT, 0},
+  {"UP",     INPUT_KIND_KEY, PIN_KEY_UP, 0},
+  {"DOWN",   INPUT_KIND_KEY, PIN_KEY_DOWN, 0},
+  {"X1_TRIM_DOWN", INPUT_KIND_TRIM, 0x01, 0},
+  {"X1_TRIM_UP",   INPUT_KIND_TRIM, 0x02, 0},
+  {"Y1_TRIM_DOWN", INPUT_KIND_TRIM, 0x04, 0},
+  {"Y1_TRIM_UP",   INPUT_KIND_TRIM, 0x08, 0},
+  {"Y2_TRIM_DOWN", INPUT_KIND_TRIM, 0x10, 0},
+  {"Y2_TRIM_UP",   INPUT_KIND_TRIM, 0x20, 0},
+  {"X2_TRIM_DOWN", INPUT_KIND_TRIM, 0x40, 0},
+  {"X2_TRIM_UP",   INPUT_KIND_TRIM, 0x80, 0},
+  {"POWER", INPUT_KIND_POWER, PIN_POWER_OFF_SENSE, 0},
+};
+
+
+//--------------------------------------------------------------------------------------------------
+
+int findInput(const char* name)
+{
+  for(uint8_t i = 0; i < MTX_NUM_INPUTS; i++)
+  {
+    if(strcasecmp(name, inputDefs[i].name) == 0)
+      return i;
+  }
+  return -1;
+}
+
+void writeInput(uint8_t inputIdx, int16_t value)
+{
+  const input_def_t* def = &inputDefs[inputIdx];
+  switch(def->kind)
+  {
+    case INPUT_KIND_ANALOG:
+      hostSetAnalogInput(def->pin, value);
+      break;
+    case INPUT_KIND_SWITCH:
+      //switch contacts pull the pin low
+      hostSetDigitalInput(def->pin,  (value == SWUPPERPOS) ? LOW : HIGH);
+      hostSetDigitalInput(def->pin2, (value == SWLOWERPOS) ? LOW : HIGH);
+      break;
+    case INPUT_KIND_KEY:
+      hostSetDigitalInput(def->pin, value ? LOW : HIGH);
+      break;
+    case INPUT_KIND_TRIM:
+      if(value)
+        PINx_TRIMS.value &= ~def->pin;
+      else
+        PINx_TRIMS.value |= def->pin;
+      break;
+    case INPUT_KIND_POWER:
+      hostSetDigitalInput(def->pin, value ? HIGH : LOW);
+      break;
+  }
+}
+
+void setDefaultInputs()
+{
+  writeInput(findInput("Y1"), 0);
+  writeInput(findInput("BATT"), 780);
+  for(uint8_t i = 0; i < MTX_NUM_INPUTS; i++)
+  {
+    if(inputDefs[i].kind == INPUT_KIND_SWITCH)
+      writeInput(i, SWUPPERPOS);
+  }
+  writeInput(findInput("POWER"), 0);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void provisionEeprom()
+{
+  resetSystemParams();
+  resetModelName();
+  resetModelParams();
+  //the init flags are checksums of the default structs
+  uint16_t fileSignature = 0xBDAC;
+  EEPROM.put(0, fileSignature);
+  EEPROM.write(2, crc8((uint8_t *) &Sys, sizeof(Sys)));
+  EEPROM.write(1027, crc8((uint8_t *) &Model, sizeof(Model)));
+  Sys.rfEnabled = true;
+  EEPROM.put(3, Sys);
+}
@@ -0,0 +1,47 @@
+/*
+ * mtx_board.h
+ * The transmitter board as seen from the host: the named inputs (sticks, switches,
+ * keys, trims) and the EEPROM state of a transmitter that has been set up.
+ * Shared by the host drivers that run the mtx firmware.
+ */
+
+#ifndef _MTX_BOARD_H_
+#define _MTX_BOARD_H_
+
+#include <stdint.h>
+
+enum {
+  INPUT_KIND_ANALOG,
+  INPUT_KIND_SWITCH,
+  INPUT_KIND_KEY,     //active low digital input, 1 = pressed
+  INPUT_KIND_TRIM,    //bit in the trims port, 1 = pressed
+  INPUT_KIND_POWER,   //power off sense, 1 = power button pressed
+};
+
+typedef struct {
+  const char* name;
+  uint8_t kind;
+  uint8_t pin;   //pin, or bit mask for trims
+  uint8_t pin2;  //second pin for switches
+} input_def_t;
+
+#define MTX_NUM_INPUTS 33
+
+extern const input_def_t inputDefs[MTX_NUM_INPUTS];
+
+//Returns the index into inputDefs, or -1 if there is no input with that name
+int findInput(const char* name);
+
+//Drives the pins of an input. Analog inputs take raw ADC values, switches
+//SWUPPERPOS, SWMIDPOS or SWLOWERPOS, the others 1 for pressed and 0 for released.
+void writeInput(uint8_t inputIdx, int16_t value);
+
+//Sticks and knobs centred, throttle closed, healthy battery, switches up, nothing pressed
+void setDefaultInputs();
+
+//Writes a formatted EEPROM with default system settings and RF output turned on, as left
+//behind by the initial setup on a real transmitter. Without this the firmware waits for
+//user input on first boot.
+void provisionEeprom();
+
+#endif
@@ -0,0 +1,489 @@
+/*
+ * mtx_host.cpp
+ *
+ * Runs the transmitter firmware (mtx) natively on the host, with a virtual clock.
+ * Stick, knob, switch and key inputs come from a script file, and the session
+ * runs as fast as the host allows. See readme.txt for the script format.
+ *
+ * Usage: mtx_host [options] script.txt
+ *   --quiet           only print the summary
+ *   --duration ms     virtual session length (default: time of last script line + 1000)
+ *   --eeprom file     load the internal EEPROM image from file and save it back on exit
+ *   --ext-eeprom      attach a 32 KB external EEPROM (24LC256)
+ *   --sd dir          use a host directory as the SD card
+ *   --trace file      write the channel outputs of every loop to a CSV file
+ *   --fresh           start with erased EEPROMs, as a new transmitter would
+ *   --profile         print the loop stage times the firmware dumps to its debug serial port
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "Wire.h"
+#include "SD.h"
+#include "HostHAL.h"
+
+#include "../config.h"
+#include "common.h"
+#include "profiler.h"
+#include "mtx_board.h"
+
+void setup();
+void loop();
+
+//==================================================================================================
+//============================ Script ==============================================================
+
+/*
+Each script line is "<time_ms> <command> [args]", lines starting with # are comments.
+  set <input> <value> [ramp <ms>]   Change an input. Analog inputs take raw ADC values 0 to 1023
+                                    and can be ramped linearly over the given time.
+  expect <chN> <min> <max>          Check channelOut of channel N at the next loop.
+  end                               End the session.
+*/
+
+enum {
+  CMD_SET,
+  CMD_EXPECT,
+  CMD_END,
+};
+
+typedef struct {
+  uint32_t time;     //in milliseconds
+  uint16_t lineNum;
+  uint8_t  cmd;
+  uint8_t  inputIdx; //index into inputDefs, or channel index for expect
+  int16_t  value;    //value, or min for expect
+  int16_t  value2;   //max for expect
+  uint32_t rampTime; //in milliseconds
+} script_event_t;
+
+#define MAX_SCRIPT_EVENTS 4096
+
+static script_event_t events[MAX_SCRIPT_EVENTS];
+static uint16_t numEvents = 0;
+static uint16_t nextEvent = 0;
+
+//active ramps, one per analog input
+typedef struct {
+  bool     active;
+  uint64_t startTime, endTime; //in microseconds
+  int16_t  startVal, endVal;
+} ramp_t;
+
+static ramp_t ramps[MTX_NUM_INPUTS];
+
+//pending channel checks, done at the end of the next loop
+static uint16_t pendingExpect[MAX_SCRIPT_EVENTS];
+static uint16_t numPendingExpect = 0;
+
+static bool isQuiet = false;
+static bool sessionEnded = false;
+
+//--------------------------------------------------------------------------------------------------
+
+static bool parseValue(const input_def_t* def, const char* str, int16_t* val)
+{
+  if(def->kind == INPUT_KIND_SWITCH)
+  {
+    if(strcasecmp(str, "U") == 0)      *val = SWUPPERPOS;
+    else if(strcasecmp(str, "M") == 0) *val = SWMIDPOS;
+    else if(strcasecmp(str, "D") == 0) *val = SWLOWERPOS;
+    else return false;
+    return true;
+  }
+  char* end;
+  long v = strtol(str, &end, 0);
+  if(*end != '\0')
+    return false;
+  if(def->kind == INPUT_KIND_ANALOG && (v < 0 || v > 1023))
+    return false;
+  if(def->kind != INPUT_KIND_ANALOG && v != 0 && v != 1)
+    return false;
+  *val = v;
+  return true;
+}
+
+static bool loadScript(const char* filename)
+{
+  FILE* fp = fopen(filename, "r");
+  if(fp == NULL)
+  {
+    fprintf(stderr, "Cannot open script %s\n", filename);
+    return false;
+  }
+
+  char line[256];
+  uint16_t lineNum = 0;
+  uint32_t lastTime = 0;
+  while(fgets(line, sizeof(line), fp) != NULL)
+  {
+    lineNum++;
+    char* tok[6];
+    uint8_t numTok = 0;
+    for(char* p = strtok(line, " \t\r\n"); p != NULL && numTok < 6; p = strtok(NULL, " \t\r\n"))
+      tok[numTok++] = p;
+    if(numTok == 0 || tok[0][0] == '#')
+      continue;
+
+    if(numEvents == MAX_SCRIPT_EVENTS)
+    {
+      fprintf(stderr, "%s:%d: too many events\n", filename, lineNum);
+      fclose(fp);
+      return false;
+    }
+    script_event_t* ev = &events[numEvents];
+    memset(ev, 0, sizeof(script_event_t));
+    ev->lineNum = lineNum;
+
+    char* end;
+    ev->time = strtoul(tok[0], &end, 10);
+    bool ok = (*end == '\0' && numTok >= 2 && ev->time >= lastTime);
+
+    if(ok && strcasecmp(tok[1], "set") == 0 && (numTok == 4 || numTok == 6))
+    {
+      int idx = findInput(tok[2]);
+      ev->cmd = CMD_SET;
+      ok = (idx >= 0);
+      if(ok)
+      {
+        ev->inputIdx = idx;
+        ok = parseValue(&inputDefs[idx], tok[3], &ev->value);
+      }
+      if(ok && numTok == 6)
+      {
+        ev->rampTime = strtoul(tok[5], &end, 10);
+        ok = (strcasecmp(tok[4], "ramp") == 0 && *end == '\0' && inputDefs[idx].kind == INPUT_KIND_ANALOG);
+      }
+    }
+    else if(ok && strcasecmp(tok[1], "expect") == 0 && numTok == 5)
+    {
+      ev->cmd = CMD_EXPECT;
+      int ch = (strncasecmp(tok[2], "ch", 2) == 0) ? atoi(tok[2] + 2) : 0;
+      ok = (ch >= 1 && ch <= NUM_RC_CHANNELS);
+      ev->inputIdx = ch - 1;
+      ev->value = atoi(tok[3]);
+      ev->value2 = atoi(tok[4]);
+    }
+    else if(ok && strcasecmp(tok[1], "end") == 0 && numTok == 2)
+      ev->cmd = CMD_END;
+    else
+      ok = false;
+
+    if(!ok)
+    {
+      fprintf(stderr, "%s:%d: invalid line\n", filename, lineNum);
+      fclose(fp);
+      return false;
+    }
+    lastTime = ev->time;
+    numEvents++;
+  }
+  fclose(fp);
+  return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//Applies the script events that are due. Called every time the virtual clock advances.
+static void applyScript()
+{
+  uint64_t now = hostTimeMicros;
+
+  for(uint8_t i = 0; i < MTX_NUM_INPUTS; i++)
+  {
+    ramp_t* r = &ramps[i];
+    if(!r->active)
+      continue;
+    if(now >= r->endTime)
+    {
+      writeInput(i, r->endVal);
+      r->active = false;
+    }
+    else
+    {
+      int32_t val = r->startVal + ((int64_t)(r->endVal - r->startVal) * (int64_t)(now - r->startTime))
+                    / (int64_t)(r->endTime - r->startTime);
+      writeInput(i, val);
+    }
+  }
+
+  while(nextEvent < numEvents && (uint64_t) events[nextEvent].time * 1000 <= now)
+  {
+    script_event_t* ev = &events[nextEvent++];
+    if(ev->cmd == CMD_SET)
+    {
+      if(!isQuiet)
+        printf("%8.3f s  set %s %d\n", now / 1e6, inputDefs[ev->inputIdx].name, ev->value);
+      if(ev->rampTime > 0)
+      {
+        ramp_t* r = &ramps[ev->inputIdx];
+        r->active = true;
+        r->startTime = now;
+        r->endTime = now + (uint64_t) ev->rampTime * 1000;
+        r->startVal = hostAnalogValue[(inputDefs[ev->inputIdx].pin - A0) % NUM_ANALOG_INPUTS];
+        r->endVal = ev->value;
+      }
+      else
+      {
+        ramps[ev->inputIdx].active = false;
+        writeInput(ev->inputIdx, ev->value);
+      }
+    }
+    else if(ev->cmd == CMD_EXPECT)
+      pendingExpect[numPendingExpect++] = nextEvent - 1;
+    else if(ev->cmd == CMD_END)
+      sessionEnded = true;
+  }
+}
+
+//==================================================================================================
+//============================ Session =============================================================
+
+static bool poweredOff = false;
+static uint32_t numLoops = 0;
+static uint32_t numFailedChecks = 0;
+static uint32_t numChecks = 0;
+
+static uint32_t serialBytes = 0;
+static uint32_t serialFrames[256];
+
+static const char* eepromFile = NULL;
+static FILE* traceFile = NULL;
+static bool printProfile = false;
+
+static std::chrono::steady_clock::time_point wallStart;
+
+//Counts the frames sent to the secondary transmitter. Frames are COBS encoded and end with a
+//zero byte. The message type follows the first code byte, unless that is 1 for a zero type.
+static void drainSerial()
+{
+  static uint8_t framePos = 0;
+  static uint8_t firstCode = 0;
+  static uint8_t frameType = 0;
+  uint8_t buff[256];
+  size_t n;
+  while((n = Serial1.hostTake(buff, sizeof(buff))) > 0)
+  {
+    serialBytes += n;
+    for(size_t i = 0; i < n; i++)
+    {
+      if(buff[i] == 0x00)
+      {
+        if(framePos > 0)
+          serialFrames[frameType]++;
+        framePos = 0;
+        continue;
+      }
+      if(framePos == 0)
+      {
+        firstCode = buff[i];
+        frameType = 0;
+      }
+      else if(framePos == 1 && firstCode > 1)
+        frameType = buff[i];
+      if(framePos < 2)
+        framePos++;
+    }
+  }
+}
+
+static void checkExpectations()
+{
+  for(uint16_t i = 0; i < numPendingExpect; i++)
+  {
+    script_event_t* ev = &events[pendingExpect[i]];
+    int16_t val = channelOut[ev->inputIdx];
+    numChecks++;
+    if(val < ev->value || val > ev->value2)
+    {
+      numFailedChecks++;
+      printf("FAIL line %d at %.3f s: ch%d is %d, expected %d to %d\n", ev->lineNum, hostTimeMicros / 1e6,
+             ev->inputIdx + 1, val, ev->value, ev->value2);
+    }
+  }
+  numPendingExpect = 0;
+}
+
+static void writeTrace()
+{
+  fprintf(traceFile, "%llu,%u", (unsigned long long)(hostTimeMicros / 1000), numLoops);
+  for(uint8_t i = 0; i < NUM_RC_CHANNELS; i++)
+    fprintf(traceFile, ",%d", channelOut[i]);
+  fprintf(traceFile, "\n");
+}
+
+static void saveEepromImage()
+{
+  if(eepromFile == NULL)
+    return;
+  FILE* fp = fopen(eepromFile, "wb");
+  if(fp == NULL || fwrite(hostEeprom, 1, HOST_EEPROM_SIZE, fp) != HOST_EEPROM_SIZE)
+    fprintf(stderr, "Cannot write %s\n", eepromFile);
+  if(fp != NULL)
+    fclose(fp);
+}
+
+static void finishSession()
+{
+  drainSerial();
+  saveEepromImage();
+  if(traceFile != NULL)
+    fclose(traceFile);
+
+  double wallSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  double virtSecs = hostTimeMicros / 1e6;
+
+  printf("---- Session summary ----\n");
+  printf("Virtual time      %.3f s\n", virtSecs);
+  printf("Host time         %.3f s (%.0fx real time)\n", wallSecs, wallSecs > 0 ? virtSecs / wallSecs : 0);
+  printf("Main loops        %u\n", numLoops);
+  printf("UART bytes out    %u\n", serialBytes);
+  printf("RC data frames    %u\n", serialFrames[0x01]);
+  printf("EEPROM writes     %u internal, %u external\n", hostEepromWriteCount, hostExtEepromWriteCount);
+  printf("LCD bus writes    %u (%.0f per loop)\n", PORTx_LCD_DATA.writeCount,
+         numLoops > 0 ? (double) PORTx_LCD_DATA.writeCount / numLoops : 0);
+  printf("Powered off       %s\n", poweredOff ? "yes" : "no");
+  printf("Channels         ");
+  for(uint8_t i = 0; i < NUM_RC_CHANNELS; i++)
+    printf(" %d", channelOut[i]);
+  printf("\n");
+  printf("Checks            %u passed, %u failed\n", numChecks - numFailedChecks, numFailedChecks);
+
+  if(printProfile)
+  {
+    printf("---- Loop profile ----\n");
+    profDumpToSerial();
+    uint8_t buff[256];
+    size_t n;
+    while((n = Serial.hostTake(buff, sizeof(buff))) > 0)
+      fwrite(buff, 1, n, stdout);
+  }
+  fflush(stdout);
+}
+
+static void onPinMode(uint8_t pin, uint8_t mode)
+{
+  //the firmware releases the power latch as its very last action on power off
+  if(pin == PIN_POWER_LATCH && mode == INPUT)
+  {
+    poweredOff = true;
+    finishSession();
+    exit(numFailedChecks > 0 ? 1 : 0);
+  }
+}
+
+static void onTimeLimit()
+{
+  printf("Firmware did not return to the main loop within the time limit\n");
+  finishSession();
+  exit(2);
+}
+
+//==================================================================================================
+
+int main(int argc, char* argv[])
+{
+  const char* scriptFile = NULL;
+  const char* traceFilename = NULL;
+  uint32_t duration = 0;
+  bool fresh = false;
+  bool extEeprom = false;
+
+  for(int i = 1; i < argc; i++)
+  {
+    if(strcmp(argv[i], "--quiet") == 0)
+      isQuiet = true;
+    else if(strcmp(argv[i], "--duration") == 0 && i + 1 < argc)
+      duration = strtoul(argv[++i], NULL, 10);
+    else if(strcmp(argv[i], "--eeprom") == 0 && i + 1 < argc)
+      eepromFile = argv[++i];
+    else if(strcmp(argv[i], "--ext-eeprom") == 0)
+      extEeprom = true;
+    else if(strcmp(argv[i], "--sd") == 0 && i + 1 < argc)
+      strlcpy_P(hostSdRoot, argv[++i], sizeof(hostSdRoot));
+    else if(strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+      traceFilename = argv[++i];
+    else if(strcmp(argv[i], "--fresh") == 0)
+      fresh = true;
+    else if(strcmp(argv[i], "--profile") == 0)
+      printProfile = true;
+    else if(argv[i][0] != '-' && scriptFile == NULL)
+      scriptFile = argv[i];
+    else
+    {
+      fprintf(stderr, "Usage: %s [--quiet] [--duration ms] [--eeprom file] [--ext-eeprom] "
+                      "[--sd dir] [--trace file] [--fresh] [--profile] script.txt\n", argv[0]);
+      return 2;
+    }
+  }
+
+  if(scriptFile == NULL || !loadScript(scriptFile))
+    return 2;
+  if(duration == 0)
+    duration = (numEvents > 0 ? events[numEvents - 1].time : 0) + 1000;
+
+  if(traceFilename != NULL)
+  {
+    traceFile = fopen(traceFilename, "w");
+    if(traceFile == NULL)
+    {
+      fprintf(stderr, "Cannot open %s\n", traceFilename);
+      return 2;
+    }
+    fprintf(traceFile, "time_ms,loop");
+    for(uint8_t i = 0; i < NUM_RC_CHANNELS; i++)
+      fprintf(traceFile, ",ch%d", i + 1);
+    fprintf(traceFile, "\n");
+  }
+
+  //--- Hardware
+  hostResetHardware();
+  hostEraseEeproms();
+  if(extEeprom)
+    hostExtEepromSize = 32768;
+
+  bool loadedImage = false;
+  if(eepromFile != NULL)
+  {
+    FILE* fp = fopen(eepromFile, "rb");
+    if(fp != NULL)
+    {
+      loadedImage = (fread(hostEeprom, 1, HOST_EEPROM_SIZE, fp) == HOST_EEPROM_SIZE);
+      fclose(fp);
+    }
+  }
+  if(!loadedImage && !fresh)
+    provisionEeprom();
+
+  setDefaultInputs();
+
+  hostOnTimeAdvance = applyScript;
+  hostOnPinMode = onPinMode;
+  hostOnTimeLimit = onTimeLimit;
+  hostTimeLimitMicros = ((uint64_t) duration + 60000) * 1000;
+
+  wallStart = std::chrono::steady_clock::now();
+
+  //--- Run
+  applyScript();
+  setup();
+  drainSerial();
+
+  while(hostTimeMicros < (uint64_t) duration * 1000 && !sessionEnded)
+  {
+    loop();
+    numLoops++;
+    drainSerial();
+    checkExpectations();
+    if(traceFile != NULL)
+      writeTrace();
+  }
+
+  finishSession();
+  return numFailedChecks > 0 ? 1 : 0;
+}
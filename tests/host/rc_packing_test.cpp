@@ -0,0 +1,283 @@
+/*
+ * rc_packing_test.cpp
+ *
+ * Checks the RC channel packing shared by mtx, stx and the receiver against the reference,
+ * the per channel encoding the RC data had when it was open coded, with a division and a
+ * modulo per channel. For every channel count from 1 to 20, random values including the
+ * failsafe Hold and No pulse values are packed at full resolution. The bytes must match the
+ * reference, nothing may be written past them, and unpacking must give back the values. Mixed
+ * resolution packets are checked to round trip as well.
+ *
+ * With --bench, it times packing and unpacking 20 channels instead, in median host cycles
+ * (nanoseconds on hosts without a cycle counter): the reference, a channel at a time through
+ * writeBits() and readBits(), and 4 channels at a time as the firmware does it.
+ *
+ * Usage: rc_packing_test [--bench] [--iterations n]
+ *   --bench           time the packing instead of checking it
+ *   --iterations n    random value sets per channel count (default 5000), or timed runs
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Arduino.h"
+
+#include "rcPacking.h"
+
+#define MAX_PACKED_SIZE  ((RC_MAX_CHANNELS * 10 + 7) / 8)
+#define GUARD_BYTE       0xA5
+
+//==================================================================================================
+//============================ Reference ===========================================================
+
+//As mtx.cpp encoded the channels, buff zeroed first
+static void packReference(uint8_t *buff, const uint16_t *values, uint8_t numChannels)
+{
+  for(uint8_t chIdx = 0; chIdx < numChannels; chIdx++)
+  {
+    uint16_t val = values[chIdx];
+    uint8_t aIdx = chIdx + (chIdx / 4);
+    uint8_t bIdx = aIdx + 1;
+    uint8_t aShift = ((chIdx % 4) + 1) * 2;
+    uint8_t bShift = 8 - aShift;
+    buff[aIdx] |= ((val >> aShift) & 0xFF);
+    buff[bIdx] |= ((val << bShift) & 0xFF);
+  }
+}
+
+//As the receiver decoded them
+static void unpackReference(const uint8_t *buff, uint16_t *values, uint8_t numChannels)
+{
+  for(uint8_t chIdx = 0; chIdx < numChannels; chIdx++)
+  {
+    uint8_t aIdx = chIdx + (chIdx / 4);
+    uint8_t bIdx = aIdx + 1;
+    uint8_t aShift = ((chIdx % 4) + 1) * 2;
+    uint8_t bShift = 8 - aShift;
+    uint16_t aMask = ((uint16_t)0x0400) - ((uint16_t)1 << aShift);
+    uint8_t  bMask = ((uint16_t)1 << (8-bShift)) - 1;
+    values[chIdx] = (((uint16_t)buff[aIdx] << aShift) & aMask) | (((uint16_t)buff[bIdx] >> bShift) & bMask);
+  }
+}
+
+//One channel at a time through the bit stream functions
+static void packBitStream(uint8_t *buff, const uint16_t *values, uint8_t numChannels)
+{
+  uint16_t bitPos = 0;
+  for(uint8_t chIdx = 0; chIdx < numChannels; chIdx++)
+    writeBits(buff, &bitPos, values[chIdx], 10);
+}
+
+static void unpackBitStream(const uint8_t *buff, uint16_t *values, uint8_t numChannels)
+{
+  uint16_t bitPos = 0;
+  for(uint8_t chIdx = 0; chIdx < numChannels; chIdx++)
+    values[chIdx] = readBits(buff, &bitPos, 10);
+}
+
+//==================================================================================================
+//============================ Checks ==============================================================
+
+static uint16_t randomValue()
+{
+  switch(rand() % 16)
+  {
+    case 0:  return 0;
+    case 1:  return 1000;
+    case 2:  return 1022; //failsafe No pulse
+    case 3:  return 1023; //failsafe Hold
+    default: return rand() % 1001;
+  }
+}
+
+static uint32_t failed = 0;
+
+static void fail(const char *what, uint8_t numChannels)
+{
+  if(failed < 10)
+    printf("FAIL %s, %u channels\n", what, numChannels);
+  failed++;
+}
+
+static void checkFull(uint8_t numChannels)
+{
+  uint16_t values[RC_MAX_CHANNELS];
+  for(uint8_t i = 0; i < numChannels; i++)
+    values[i] = randomValue();
+  uint8_t length = (numChannels * 10 + 7) / 8;
+
+  uint8_t ref[MAX_PACKED_SIZE + 1];
+  memset(ref, 0, sizeof(ref));
+  packReference(ref, values, numChannels);
+
+  uint8_t buff[MAX_PACKED_SIZE + 1];
+  memset(buff, GUARD_BYTE, sizeof(buff));
+  packFullRCChannels(buff, values, numChannels);
+  if(memcmp(buff, ref, length) != 0)
+    fail("packFullRCChannels() differs from the reference", numChannels);
+  if(buff[length] != GUARD_BYTE)
+    fail("packFullRCChannels() writes past the end", numChannels);
+
+  uint16_t out[RC_MAX_CHANNELS + 1];
+  out[numChannels] = 0xFFFF;
+  unpackFullRCChannels(ref, out, numChannels);
+  if(memcmp(out, values, numChannels * sizeof(values[0])) != 0)
+    fail("unpackFullRCChannels() does not give back the values", numChannels);
+  if(out[numChannels] != 0xFFFF)
+    fail("unpackFullRCChannels() writes past the end", numChannels);
+
+  uint16_t refOut[RC_MAX_CHANNELS];
+  unpackReference(ref, refOut, numChannels);
+  if(memcmp(refOut, values, numChannels * sizeof(values[0])) != 0)
+    fail("reference does not give back the values", numChannels);
+
+  //the unpacked count comes from the length, the padding being shorter than a channel
+  if(unpackRCChannels(buff, length, out, false) != numChannels
+     || memcmp(out, values, numChannels * sizeof(values[0])) != 0)
+    fail("unpackRCChannels() does not give back the values", numChannels);
+}
+
+static void checkMixed(uint8_t numChannels)
+{
+  uint16_t values[RC_MAX_CHANNELS];
+  uint8_t buff[RC_MAX_CHANNELS * 11 / 8 + 1];
+  memset(buff, 0, sizeof(buff));
+  uint16_t bitPos = 0;
+  for(uint8_t i = 0; i < numChannels; i++)
+  {
+    uint8_t resolution = rand() % 2;
+    values[i] = (resolution == RC_CHANNEL_SWITCH) ? (rand() % 3) * 500 : rand() % 1001;
+    packRCChannel(buff, &bitPos, values[i], resolution, true);
+  }
+
+  uint16_t out[RC_MAX_CHANNELS];
+  if(unpackRCChannels(buff, (bitPos + 7) / 8, out, true) != numChannels
+     || memcmp(out, values, numChannels * sizeof(values[0])) != 0)
+    fail("mixed resolution does not round trip", numChannels);
+}
+
+//==================================================================================================
+//============================ Bench ===============================================================
+
+static inline uint64_t readCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+typedef struct {
+  const char *name;
+  void (*pack)(uint8_t *buff, const uint16_t *values, uint8_t numChannels);
+  void (*unpack)(const uint8_t *buff, uint16_t *values, uint8_t numChannels);
+  bool needsZeroing;
+} codec_t;
+
+static const codec_t codecs[] = {
+  {"reference",   packReference,      unpackReference,      true},
+  {"bit stream",  packBitStream,      unpackBitStream,      true},
+  {"groups of 4", packFullRCChannels, unpackFullRCChannels, false},
+};
+
+#define NUM_CODECS (sizeof(codecs) / sizeof(codecs[0]))
+
+//Median cycles to pack and to unpack 20 channels, zeroing the buffer counted when needed
+static void timeCodec(const codec_t *codec, uint32_t runs, uint64_t *packTime, uint64_t *unpackTime)
+{
+  std::vector<uint64_t> packSamples, unpackSamples;
+  packSamples.reserve(runs);
+  unpackSamples.reserve(runs);
+  uint16_t values[RC_MAX_CHANNELS];
+  uint16_t out[RC_MAX_CHANNELS];
+  uint8_t buff[MAX_PACKED_SIZE];
+  uint32_t sum = 0;
+
+  for(uint32_t i = 0; i < runs; i++)
+  {
+    for(uint8_t ch = 0; ch < RC_MAX_CHANNELS; ch++)
+      values[ch] = randomValue();
+
+    uint64_t start = readCycles();
+    if(codec->needsZeroing)
+      memset(buff, 0, sizeof(buff));
+    codec->pack(buff, values, RC_MAX_CHANNELS);
+    asm volatile("" : : "r"(buff) : "memory");
+    packSamples.push_back(readCycles() - start);
+
+    start = readCycles();
+    codec->unpack(buff, out, RC_MAX_CHANNELS);
+    asm volatile("" : : "r"(out) : "memory");
+    unpackSamples.push_back(readCycles() - start);
+
+    sum += out[i % RC_MAX_CHANNELS];
+  }
+  if(sum == 0xFFFFFFFF)
+    printf("\n");
+
+  std::sort(packSamples.begin(), packSamples.end());
+  std::sort(unpackSamples.begin(), unpackSamples.end());
+  *packTime = packSamples[runs / 2];
+  *unpackTime = unpackSamples[runs / 2];
+}
+
+//==================================================================================================
+
+int main(int argc, char* argv[])
+{
+  bool isBench = false;
+  uint32_t iterations = 5000;
+
+  for(int i = 1; i < argc; i++)
+  {
+    if(strcmp(argv[i], "--bench") == 0)
+      isBench = true;
+    else if(strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+      iterations = strtoul(argv[++i], NULL, 10);
+    else
+    {
+      fprintf(stderr, "Usage: %s [--bench] [--iterations n]\n", argv[0]);
+      return 2;
+    }
+  }
+  if(iterations == 0)
+    iterations = 1;
+
+  srand(1);
+
+  if(isBench)
+  {
+    printf("RC packing, 20 channels, %u runs, median host cycles\n", iterations);
+    printf("  %-12s %8s %8s\n", "", "pack", "unpack");
+    for(uint8_t c = 0; c < NUM_CODECS; c++)
+    {
+      uint64_t packTime, unpackTime;
+      timeCodec(&codecs[c], iterations, &packTime, &unpackTime);
+      printf("  %-12s %8llu %8llu\n", codecs[c].name,
+             (unsigned long long) packTime, (unsigned long long) unpackTime);
+    }
+    return 0;
+  }
+
+  for(uint8_t numChannels = 1; numChannels <= RC_MAX_CHANNELS; numChannels++)
+  {
+    for(uint32_t i = 0; i < iterations; i++)
+    {
+      checkFull(numChannels);
+      checkMixed(numChannels);
+    }
+  }
+
+  printf("RC packing         channel counts 1 to %u, %u value sets each, %u failed\n",
+         RC_MAX_CHANNELS, iterations, failed);
+  return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+/*
+ * SimDevice.h
+ *
+ * Interface between the system simulator and the firmwares it runs. Each firmware is
+ * built together with its own copy of the Arduino shim into a shared library, so that
+ * mtx, stx and the receiver can be loaded into one process without their globals
+ * (Sys, loop, Serial, ...) clashing. The library exports simDevice() only.
+ *
+ * Every device runs on its own stack and has its own virtual clock. A device runs
+ * until its clock reaches the deadline given by the simulator, then hands over with
+ * sync(), so the clocks of the devices never drift apart by more than a few tens of
+ * microseconds.
+ */
+
+#ifndef _SIM_DEVICE_H_
+#define _SIM_DEVICE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../arduino/SX127x.h"
+
+typedef struct {
+  uint8_t id;
+  //Called when the device clock reaches the deadline. Returns when it is the turn of
+  //the device again, with the new deadline.
+  uint64_t (*sync)(uint64_t now);
+  const host_radio_medium_t *radio;
+} sim_host_t;
+
+typedef struct {
+  const char *name;
+
+  void     (*init)(const sim_host_t *host); //power-on state, with a set up EEPROM
+  void     (*run)();                        //setup() then loop() for ever, never returns
+  uint64_t (*time)();                       //virtual clock, in microseconds
+  uint32_t (*loops)();                      //number of loop() calls completed
+
+  //The UART between the two MCUs of the transmitter, Serial1 on mtx and Serial on stx
+  size_t   (*uartTake)(uint8_t *data, size_t maxLen);
+  size_t   (*uartInject)(const uint8_t *data, size_t len);
+  uint32_t (*uartBaud)();
+
+  //Device specific, NULL where they do not apply
+  const host_radio_stats_t* (*radioStats)();
+  bool     (*setInput)(const char *name, int16_t value); //mtx inputs, see mtx_board.h
+  int16_t  (*channelOut)(uint8_t idx);
+  //Bound with the frame rate given as in rf_frame_rate_e of mtx. mtx only takes the frame rate.
+  void     (*bind)(uint8_t transmitterID, uint8_t receiverID, const uint8_t *fhssSchema, uint8_t frameRate);
+  //Hook called at the end of every servo pulse of the receiver, channel index from 0
+  void     (*onServoPulse)(void (*hook)(uint8_t ch, uint64_t startTime, uint32_t width));
+  //RC data from mtx that stx replaced with newer data before sending it
+  uint32_t (*rcDataDropped)();
+} sim_device_t;
+
+#define SIM_DEVICE_EXPORT extern "C" __attribute__((visibility("default")))
+
+SIM_DEVICE_EXPORT const sim_device_t* simDevice();
+
+//--- Helpers shared by the device libraries, see device.cpp
+
+void     simDeviceInit(const sim_host_t *host);
+void     simDeviceRun(void (*afterSetup)());
+uint64_t simDeviceTime();
+uint32_t simDeviceLoops();
+const host_radio_stats_t* simDeviceRadioStats();
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * device.cpp
+ * Glue common to the device libraries of the system simulator: runs the firmware on
+ * the device stack and hands over to the simulator whenever the virtual clock reaches
+ * the deadline.
+ */
+
+#include "Arduino.h"
+#include "HostHAL.h"
+
+#include "SimDevice.h"
+
+void setup();
+void loop();
+
+static const sim_host_t *simHost = NULL;
+static uint64_t deadline = 0;
+static uint32_t numLoops = 0;
+
+//--------------------------------------------------------------------------------------------------
+
+static void onTimeAdvance()
+{
+  if(hostTimeMicros >= deadline)
+    deadline = simHost->sync(hostTimeMicros);
+}
+
+void simDeviceInit(const sim_host_t *host)
+{
+  simHost = host;
+  hostResetHardware();
+  hostEraseEeproms();
+  deadline = 0;
+  numLoops = 0;
+}
+
+void simDeviceRun(void (*afterSetup)())
+{
+  //only from here on the device runs on its own stack and can hand over
+  hostOnTimeAdvance = onTimeAdvance;
+  setup();
+  if(afterSetup != NULL)
+    afterSetup();
+  for(;;)
+  {
+    loop();
+    numLoops++;
+    //the Arduino main() has some work of its own between loop() calls
+    hostAdvanceTime(1);
+  }
+}
+
+uint64_t simDeviceTime()
+{
+  return hostTimeMicros;
+}
+
+uint32_t simDeviceLoops()
+{
+  return numLoops;
+}
+
+const host_radio_stats_t* simDeviceRadioStats()
+{
+  return &hostRadioStats;
+}
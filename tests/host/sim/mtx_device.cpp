@@ -0,0 +1,96 @@
+/*
+ * mtx_device.cpp
+ * The transmitter main MCU (mtx) as a device of the system simulator.
+ * It boots with a set up EEPROM and RF output on, like mtx_host does, and always
+ * asks the receiver for telemetry, as it does when the telemetry screen is open.
+ */
+
+#include "Arduino.h"
+#include "HostHAL.h"
+
+#include "../config.h"
+#include "common.h"
+#include "../mtx_board.h"
+#include "SimDevice.h"
+
+static uint8_t frameRate = RF_FRAME_RATE_50HZ;
+
+static void init(const sim_host_t *host)
+{
+  simDeviceInit(host);
+  provisionEeprom();
+  setDefaultInputs();
+  telemetryForceRequest = true;
+}
+
+//Set once setup() has loaded the system settings, the RC task takes it from the next frame on
+static void applyFrameRate()
+{
+  Sys.rfFrameRate = frameRate;
+}
+
+static void run()
+{
+  simDeviceRun(applyFrameRate);
+}
+
+static void bind(uint8_t transmitterID, uint8_t receiverID, const uint8_t *fhssSchema, uint8_t rate)
+{
+  (void) transmitterID;
+  (void) receiverID;
+  (void) fhssSchema;
+  frameRate = rate;
+}
+
+static size_t uartTake(uint8_t *data, size_t maxLen)
+{
+  return Serial1.hostTake(data, maxLen);
+}
+
+static size_t uartInject(const uint8_t *data, size_t len)
+{
+  return Serial1.hostInject(data, len);
+}
+
+static uint32_t uartBaud()
+{
+  return Serial1.baudRate;
+}
+
+static bool setInput(const char *name, int16_t value)
+{
+  int idx = findInput(name);
+  if(idx < 0)
+    return false;
+  writeInput(idx, value);
+  return true;
+}
+
+static int16_t getChannelOut(uint8_t idx)
+{
+  return idx < NUM_RC_CHANNELS ? channelOut[idx] : 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+static const sim_device_t device = {
+  "mtx",
+  init,
+  run,
+  simDeviceTime,
+  simDeviceLoops,
+  uartTake,
+  uartInject,
+  uartBaud,
+  NULL,
+  setInput,
+  getChannelOut,
+  bind,
+  NULL,
+  NULL,
+};
+
+const sim_device_t* simDevice()
+{
+  return &device;
+}
@@ -0,0 +1,113 @@
+/*
+ * receiver_device.cpp
+ * The receiver as a device of the system simulator. The servo outputs are driven by the
+ * Servo library from the Timer1 compare interrupt, so the pulses seen here have the
+ * timing of the real board. Nothing is connected to the GNSS serial port.
+ */
+
+#include "Arduino.h"
+#include "HostHAL.h"
+
+#include "../config.h"
+#include "common.h"
+#include "eestore.h"
+#include "SimDevice.h"
+
+extern int16_t outputPin[MAX_CHANNELS_PER_RECEIVER];
+
+static uint8_t bindTransmitterID;
+static uint8_t bindReceiverID;
+static uint8_t bindFhssSchema[NUM_HOP_CHANNELS];
+static uint8_t bindFrameRate;
+static bool    isBound = false;
+
+static void (*servoPulseHook)(uint8_t ch, uint64_t startTime, uint32_t width) = NULL;
+static uint64_t pulseStartTime[MAX_CHANNELS_PER_RECEIVER];
+
+//--------------------------------------------------------------------------------------------------
+
+static void onDigitalWrite(uint8_t pin, uint8_t val)
+{
+  for(uint8_t ch = 0; ch < MAX_CHANNELS_PER_RECEIVER; ch++)
+  {
+    if(outputPin[ch] != pin)
+      continue;
+    if(val == HIGH)
+      pulseStartTime[ch] = hostTimeMicros;
+    else if(pulseStartTime[ch] != 0)
+    {
+      if(servoPulseHook != NULL)
+        servoPulseHook(ch, pulseStartTime[ch], hostTimeMicros - pulseStartTime[ch]);
+      pulseStartTime[ch] = 0;
+    }
+  }
+}
+
+static void init(const sim_host_t *host)
+{
+  simDeviceInit(host);
+  hostRadioAttach(host->id, host->radio);
+  hostOnDigitalWrite = onDigitalWrite;
+}
+
+//Applied once setup() has initialised the EEPROM, as if bound before. The receiver
+//still listens for a bind request for a while after power on.
+static void applyBinding()
+{
+  if(!isBound)
+    return;
+  Sys.transmitterID = bindTransmitterID;
+  Sys.receiverID = bindReceiverID;
+  memcpy(Sys.fhss_schema, bindFhssSchema, sizeof(Sys.fhss_schema));
+  Sys.isMainReceiver = true;
+  Sys.frameRate = bindFrameRate;
+  eeSaveSysConfig();
+}
+
+static void run()
+{
+  simDeviceRun(applyBinding);
+}
+
+static void bind(uint8_t transmitterID, uint8_t receiverID, const uint8_t *fhssSchema, uint8_t frameRate)
+{
+  bindTransmitterID = transmitterID;
+  bindReceiverID = receiverID;
+  memcpy(bindFhssSchema, fhssSchema, sizeof(bindFhssSchema));
+  bindFrameRate = frameRate;
+  isBound = true;
+}
+
+static int16_t getChannelOut(uint8_t idx)
+{
+  return idx < MAX_CHANNELS_PER_RECEIVER ? channelOut[idx] : 0;
+}
+
+static void onServoPulse(void (*hook)(uint8_t ch, uint64_t startTime, uint32_t width))
+{
+  servoPulseHook = hook;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+static const sim_device_t device = {
+  "receiver",
+  init,
+  run,
+  simDeviceTime,
+  simDeviceLoops,
+  NULL,
+  NULL,
+  NULL,
+  simDeviceRadioStats,
+  NULL,
+  getChannelOut,
+  bind,
+  onServoPulse,
+  NULL,
+};
+
+const sim_device_t* simDevice()
+{
+  return &device;
+}
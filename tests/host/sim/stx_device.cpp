@@ -0,0 +1,95 @@
+/*
+ * stx_device.cpp
+ * The transmitter secondary MCU (stx) as a device of the system simulator. Its LoRa
+ * module is the register level model in SX127x.cpp, on the simulator radio medium.
+ */
+
+#include "Arduino.h"
+#include "HostHAL.h"
+
+#include "../config.h"
+#include "common.h"
+#include "eestore.h"
+#include "SimDevice.h"
+
+static uint8_t bindTransmitterID;
+static uint8_t bindReceiverID;
+static uint8_t bindFhssSchema[NUM_HOP_CHANNELS];
+static bool    isBound = false;
+
+static void init(const sim_host_t *host)
+{
+  simDeviceInit(host);
+  hostRadioAttach(host->id, host->radio);
+}
+
+//The binding is applied once setup() has initialised the EEPROM, as if the
+//transmitter had been bound to the receiver before
+static void applyBinding()
+{
+  if(!isBound)
+    return;
+  Sys.transmitterID = bindTransmitterID;
+  Sys.receiverID = bindReceiverID;
+  memcpy(Sys.fhss_schema, bindFhssSchema, sizeof(Sys.fhss_schema));
+  eeSaveSysConfig();
+}
+
+static void run()
+{
+  simDeviceRun(applyBinding);
+}
+
+//The frame rate comes with the RC data from mtx
+static void bind(uint8_t transmitterID, uint8_t receiverID, const uint8_t *fhssSchema, uint8_t frameRate)
+{
+  bindTransmitterID = transmitterID;
+  bindReceiverID = receiverID;
+  memcpy(bindFhssSchema, fhssSchema, sizeof(bindFhssSchema));
+  (void) frameRate;
+  isBound = true;
+}
+
+static size_t uartTake(uint8_t *data, size_t maxLen)
+{
+  return Serial.hostTake(data, maxLen);
+}
+
+static size_t uartInject(const uint8_t *data, size_t len)
+{
+  return Serial.hostInject(data, len);
+}
+
+static uint32_t uartBaud()
+{
+  return Serial.baudRate;
+}
+
+static uint32_t rcDataDropped()
+{
+  return rcDataDropCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+static const sim_device_t device = {
+  "stx",
+  init,
+  run,
+  simDeviceTime,
+  simDeviceLoops,
+  uartTake,
+  uartInject,
+  uartBaud,
+  simDeviceRadioStats,
+  NULL,
+  NULL,
+  bind,
+  NULL,
+  rcDataDropped,
+};
+
+const sim_device_t* simDevice()
+{
+  return &device;
+}
@@ -0,0 +1,582 @@
+/*
+ * system_sim.cpp
+ *
+ * Runs the whole radio system on the host: the transmitter main MCU (mtx), the
+ * transmitter RF MCU (stx) and the receiver, each its own unmodified firmware with
+ * its own virtual clock. mtx and stx are linked by a UART at the baud rate they
+ * configure, stx and the receiver by emulated LoRa modules on a shared radio medium.
+ *
+ * The aileron stick is stepped back and forth, and the simulator measures:
+ *  - stick to servo latency, from the stick step to the start of the first servo
+ *    pulse on receiver channel 1 with the new position
+ *  - RF packet rate, at the stx and at the receiver, which should be close to the frame
+ *    rate, and the air time per packet, which should fit in the frame
+ *  - telemetry period, from the end of a telemetry frame received by mtx to the end
+ *    of the next one, which the stx frame schedule should keep steady, and its rate
+ *  - RC data from mtx dropped by stx, which must be none
+ *
+ * Usage: system_sim [options]
+ *   --quiet           only print the summary
+ *   --duration ms     virtual session length (default 20000)
+ *   --step ms         time between aileron stick steps (default 230)
+ *   --frame-rate hz   RC frame rate, 50, 100 or 150 (default 50)
+ *   --rc-jitter us    holds each message from mtx back a random 0 to us on the UART
+ *   --lib dir         directory with the device libraries (default: sim/ next to the executable)
+ */
+
+#include <chrono>
+#include <algorithm>
+#include <vector>
+#include <dlfcn.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "SimDevice.h"
+
+#define NUM_DEVICES 3
+
+enum {
+  DEV_MTX = 0,
+  DEV_STX = 1,
+  DEV_RECEIVER = 2,
+};
+
+static const char* deviceLibs[NUM_DEVICES] = {"mtx.so", "stx.so", "receiver.so"};
+
+//Maximum lead of a device clock over the slowest one. Bytes on the UART and packets
+//on air are seen by the other side at most this late.
+#define SYNC_QUANTUM_US 50
+
+#define DEVICE_STACK_SIZE (1024 * 1024)
+
+//Measurements start after the receiver has finished listening for a bind on power on
+#define WARMUP_US 2000000
+
+//Aileron stick positions, raw ADC values
+#define STICK_LOW  100
+#define STICK_HIGH 923
+
+//A servo pulse shows the new stick position once it is this far from centre
+#define SERVO_CENTRE_US    1500
+#define SERVO_THRESHOLD_US 200
+
+//Frame rates, in the order of rf_frame_rate_e of mtx
+static const uint16_t frameRates[] = {50, 100, 150};
+
+//UART message layout, see protocol_over_uart.txt
+#define UART_MAX_MESSAGE_SIZE 45 //type, length, up to 42 bytes of data and CRC
+#define MESSAGE_TYPE_RC_DATA 0x01
+#define MESSAGE_TYPE_TELEMETRY_RF_LINK_PACKET_RATE 0x13
+#define MESSAGE_TYPE_TELEMETRY_GENERAL 0x14
+
+//==================================================================================================
+//============================ Radio medium ========================================================
+
+#define MEDIUM_PACKETS_KEPT 64
+
+static host_radio_packet_t mediumPackets[MEDIUM_PACKETS_KEPT];
+static uint32_t mediumNextSeq = 0;
+
+static uint32_t mediumTransmit(const host_radio_packet_t *packet)
+{
+  host_radio_packet_t *p = &mediumPackets[mediumNextSeq % MEDIUM_PACKETS_KEPT];
+  *p = *packet;
+  p->seq = mediumNextSeq;
+  return mediumNextSeq++;
+}
+
+static uint32_t mediumOldestSeq()
+{
+  return mediumNextSeq > MEDIUM_PACKETS_KEPT ? mediumNextSeq - MEDIUM_PACKETS_KEPT : 0;
+}
+
+static uint32_t mediumGetNextSeq()
+{
+  return mediumNextSeq;
+}
+
+static const host_radio_packet_t* mediumPacket(uint32_t seq)
+{
+  if(seq >= mediumNextSeq || seq < mediumOldestSeq())
+    return NULL;
+  return &mediumPackets[seq % MEDIUM_PACKETS_KEPT];
+}
+
+static void mediumAbort(uint32_t seq, uint64_t time)
+{
+  host_radio_packet_t *p = (host_radio_packet_t *) mediumPacket(seq);
+  if(p != NULL && time < p->endTime)
+  {
+    p->aborted = true;
+    p->endTime = time;
+  }
+}
+
+static const host_radio_medium_t medium = {
+  mediumTransmit,
+  mediumAbort,
+  mediumPacket,
+  mediumOldestSeq,
+  mediumGetNextSeq,
+};
+
+//==================================================================================================
+//============================ Devices and scheduling ==============================================
+
+typedef struct {
+  const sim_device_t *dev;
+  sim_host_t host;
+  ucontext_t context;
+  uint64_t deadline;
+  bool started;
+} device_slot_t;
+
+static device_slot_t devices[NUM_DEVICES];
+static uint8_t currentDevice;
+static ucontext_t schedulerContext;
+
+static uint64_t nextStepTime;
+
+static uint64_t syncDevice(uint64_t now)
+{
+  (void) now;
+  device_slot_t *slot = &devices[currentDevice];
+  swapcontext(&slot->context, &schedulerContext);
+  return slot->deadline;
+}
+
+static void deviceEntry()
+{
+  devices[currentDevice].dev->run();
+}
+
+static bool loadDevices(const char *libDir)
+{
+  for(uint8_t i = 0; i < NUM_DEVICES; i++)
+  {
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%s", libDir, deviceLibs[i]);
+    //RTLD_LOCAL keeps the globals of each firmware to its own library
+    void *lib = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if(lib == NULL)
+    {
+      fprintf(stderr, "%s\n", dlerror());
+      return false;
+    }
+    const sim_device_t* (*getDevice)() = (const sim_device_t* (*)()) dlsym(lib, "simDevice");
+    if(getDevice == NULL)
+    {
+      fprintf(stderr, "%s: no simDevice()\n", path);
+      return false;
+    }
+    device_slot_t *slot = &devices[i];
+    slot->dev = getDevice();
+    slot->host.id = i;
+    slot->host.sync = syncDevice;
+    slot->host.radio = &medium;
+
+    getcontext(&slot->context);
+    slot->context.uc_stack.ss_sp = malloc(DEVICE_STACK_SIZE);
+    slot->context.uc_stack.ss_size = DEVICE_STACK_SIZE;
+    slot->context.uc_link = NULL;
+    makecontext(&slot->context, deviceEntry, 0);
+  }
+  return true;
+}
+
+//==================================================================================================
+//============================ UART link ===========================================================
+
+typedef struct {
+  uint8_t  data;
+  uint64_t arrivalTime;
+} uart_byte_t;
+
+typedef struct {
+  uint8_t  from, to;
+  uint64_t lineFreeTime;
+  std::vector<uart_byte_t> inFlight;
+  uint32_t bytes;
+  uint32_t dropped;
+  //frame decoding
+  uint8_t  frame[UART_MAX_MESSAGE_SIZE]; //the decoded message
+  uint8_t  frameLen;
+  uint8_t  blockLeft;
+  bool     hasZero;
+  bool     isInFrame;
+  uint64_t frameStartTime;
+} uart_link_t;
+
+static uart_link_t links[2] = {
+  {DEV_MTX, DEV_STX, 0, {}, 0, 0, {0}, 0, 0, false, false, 0},
+  {DEV_STX, DEV_MTX, 0, {}, 0, 0, {0}, 0, 0, false, false, 0},
+};
+
+static void onUartFrame(uart_link_t *link, uint64_t startTime, uint64_t endTime);
+
+//Too long frames are counted on, and dropped at the delimiter
+static void addFrameByte(uart_link_t *link, uint8_t c)
+{
+  if(link->frameLen < UART_MAX_MESSAGE_SIZE)
+    link->frame[link->frameLen] = c;
+  if(link->frameLen <= UART_MAX_MESSAGE_SIZE)
+    link->frameLen++;
+}
+
+//Decodes the COBS frames of the byte stream, each ends with a zero byte
+static void decodeUartByte(uart_link_t *link, uint8_t c, uint64_t sendTime, uint64_t arrivalTime)
+{
+  if(c == 0x00)
+  {
+    if(link->blockLeft == 0 && link->frameLen >= 3 && link->frameLen <= UART_MAX_MESSAGE_SIZE)
+      onUartFrame(link, link->frameStartTime, arrivalTime);
+    link->frameLen = 0;
+    link->blockLeft = 0;
+    link->hasZero = false;
+    link->isInFrame = false;
+    return;
+  }
+  if(!link->isInFrame)
+  {
+    link->isInFrame = true;
+    link->frameStartTime = sendTime;
+  }
+  if(link->blockLeft == 0) //code byte
+  {
+    if(link->hasZero)
+      addFrameByte(link, 0);
+    link->blockLeft = c - 1;
+    link->hasZero = (c != 0xFF);
+  }
+  else
+  {
+    addFrameByte(link, c);
+    link->blockLeft--;
+  }
+}
+
+//Maximum delay of a message from mtx before it goes out, as when the RC task runs late
+static uint32_t rcJitter = 0;
+
+static uint32_t nextRandom()
+{
+  static uint32_t state = 0x2545F491;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+//Bytes written by the sender go out back to back, 10 bits each at the sender baud rate
+static void collectUartBytes(uart_link_t *link)
+{
+  const sim_device_t *dev = devices[link->from].dev;
+  uint64_t now = dev->time();
+  uint32_t baud = dev->uartBaud();
+  uint8_t buff[256];
+  size_t n;
+  while((n = dev->uartTake(buff, sizeof(buff))) > 0)
+  {
+    for(size_t i = 0; i < n; i++)
+    {
+      uint64_t startTime = std::max(now, link->lineFreeTime);
+      if(link->from == DEV_MTX && !link->isInFrame && rcJitter > 0)
+        startTime = std::max(now + nextRandom() % (rcJitter + 1), link->lineFreeTime);
+      link->lineFreeTime = startTime + (10000000ULL / baud + 9) / 10;
+      link->inFlight.push_back({buff[i], link->lineFreeTime});
+      link->bytes++;
+      decodeUartByte(link, buff[i], startTime, link->lineFreeTime);
+    }
+  }
+}
+
+static void deliverUartBytes(uart_link_t *link)
+{
+  const sim_device_t *dev = devices[link->to].dev;
+  uint64_t now = dev->time();
+  size_t n = 0;
+  while(n < link->inFlight.size() && link->inFlight[n].arrivalTime <= now)
+  {
+    //bytes that find the receive buffer full are lost
+    if(dev->uartInject(&link->inFlight[n].data, 1) == 0)
+      link->dropped++;
+    n++;
+  }
+  link->inFlight.erase(link->inFlight.begin(), link->inFlight.begin() + n);
+}
+
+//==================================================================================================
+//============================ Measurements ========================================================
+
+static bool isQuiet = false;
+
+static std::vector<double> latencySamples;
+static std::vector<double> telemetrySamples;
+
+static uint64_t stepTime = 0;
+static int8_t   stepDirection = 0; //1 towards STICK_HIGH, -1 towards STICK_LOW, 0 when answered
+static uint32_t numSteps = 0;
+static uint32_t numUnansweredSteps = 0;
+
+static uint64_t lastTelemetryTime = 0;
+static uint32_t numTelemetry = 0;
+
+static uint32_t numRcData = 0;
+static uint32_t rcDroppedAtWarmup = 0;
+
+static uint8_t  reportedTxPacketRate = 0;
+static uint8_t  reportedRxPacketRate = 0;
+
+static host_radio_stats_t radioAtWarmup[NUM_DEVICES];
+static bool hasWarmedUp = false;
+
+static void onUartFrame(uart_link_t *link, uint64_t startTime, uint64_t endTime)
+{
+  uint8_t type = link->frame[0];
+  uint8_t len = link->frame[1];
+  if(len == 0 || len != link->frameLen - 3)
+    return;
+
+  if(link->from == DEV_MTX && type == MESSAGE_TYPE_RC_DATA)
+  {
+    if(hasWarmedUp)
+      numRcData++;
+  }
+  else if(link->from == DEV_STX && type == MESSAGE_TYPE_TELEMETRY_GENERAL)
+  {
+    if(!hasWarmedUp)
+      return;
+    if(numTelemetry > 0)
+      telemetrySamples.push_back((endTime - lastTelemetryTime) / 1000.0);
+    lastTelemetryTime = endTime;
+    numTelemetry++;
+  }
+  else if(link->from == DEV_STX && type == MESSAGE_TYPE_TELEMETRY_RF_LINK_PACKET_RATE)
+  {
+    reportedTxPacketRate = link->frame[2];
+    reportedRxPacketRate = link->frame[3];
+  }
+}
+
+static void stepStick()
+{
+  const sim_device_t *mtx = devices[DEV_MTX].dev;
+  if(stepDirection != 0)
+    numUnansweredSteps++;
+  static bool isHigh = false;
+  isHigh = !isHigh;
+  mtx->setInput("X2", isHigh ? STICK_HIGH : STICK_LOW);
+  stepTime = mtx->time();
+  stepDirection = isHigh ? 1 : -1;
+  numSteps++;
+  if(!isQuiet)
+    printf("%8.3f s  aileron stick %s\n", stepTime / 1e6, isHigh ? "right" : "left");
+}
+
+static void onServoPulse(uint8_t ch, uint64_t startTime, uint32_t width)
+{
+  if(ch != 0 || stepDirection == 0 || startTime < stepTime)
+    return;
+  if((stepDirection > 0 && width > SERVO_CENTRE_US + SERVO_THRESHOLD_US)
+     || (stepDirection < 0 && width < SERVO_CENTRE_US - SERVO_THRESHOLD_US))
+  {
+    latencySamples.push_back((startTime - stepTime) / 1000.0);
+    stepDirection = 0;
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+static void printStats(const char *label, std::vector<double> &samples, const char *extra)
+{
+  if(samples.empty())
+  {
+    printf("%-18s no samples%s\n", label, extra);
+    return;
+  }
+  std::sort(samples.begin(), samples.end());
+  double sum = 0;
+  for(double v : samples)
+    sum += v;
+  printf("%-18s n=%u  min %.1f  avg %.1f  p95 %.1f  max %.1f ms%s\n", label, (unsigned) samples.size(),
+         samples.front(), sum / samples.size(), samples[(samples.size() * 95) / 100], samples.back(), extra);
+}
+
+//==================================================================================================
+
+int main(int argc, char* argv[])
+{
+  uint32_t duration = 20000;
+  uint32_t stepInterval = 230;
+  uint16_t frameRateHz = 50;
+  const char *libDir = NULL;
+
+  for(int i = 1; i < argc; i++)
+  {
+    if(strcmp(argv[i], "--quiet") == 0)
+      isQuiet = true;
+    else if(strcmp(argv[i], "--duration") == 0 && i + 1 < argc)
+      duration = strtoul(argv[++i], NULL, 10);
+    else if(strcmp(argv[i], "--step") == 0 && i + 1 < argc)
+      stepInterval = strtoul(argv[++i], NULL, 10);
+    else if(strcmp(argv[i], "--frame-rate") == 0 && i + 1 < argc)
+      frameRateHz = strtoul(argv[++i], NULL, 10);
+    else if(strcmp(argv[i], "--rc-jitter") == 0 && i + 1 < argc)
+      rcJitter = strtoul(argv[++i], NULL, 10);
+    else if(strcmp(argv[i], "--lib") == 0 && i + 1 < argc)
+      libDir = argv[++i];
+    else
+    {
+      fprintf(stderr, "Usage: %s [--quiet] [--duration ms] [--step ms] [--frame-rate hz] [--rc-jitter us] [--lib dir]\n", argv[0]);
+      return 2;
+    }
+  }
+  uint8_t frameRate = 0;
+  while(frameRate < sizeof(frameRates) / sizeof(frameRates[0]) && frameRates[frameRate] != frameRateHz)
+    frameRate++;
+  if(frameRate == sizeof(frameRates) / sizeof(frameRates[0]))
+  {
+    fprintf(stderr, "Frame rate must be 50, 100 or 150 Hz\n");
+    return 2;
+  }
+  if(stepInterval == 0 || duration * 1000ULL <= WARMUP_US)
+  {
+    fprintf(stderr, "Duration must be more than %d ms\n", WARMUP_US / 1000);
+    return 2;
+  }
+
+  //by default the libraries are in sim/ next to the executable
+  char exeDir[PATH_MAX];
+  if(libDir == NULL)
+  {
+    ssize_t len = readlink("/proc/self/exe", exeDir, sizeof(exeDir) - 1);
+    exeDir[len > 0 ? len : 0] = '\0';
+    char *slash = strrchr(exeDir, '/');
+    if(slash != NULL)
+      strcpy(slash, "/sim");
+    else
+      strcpy(exeDir, "sim");
+    libDir = exeDir;
+  }
+
+  if(!loadDevices(libDir))
+    return 2;
+
+  for(uint8_t i = 0; i < NUM_DEVICES; i++)
+    devices[i].dev->init(&devices[i].host);
+
+  //start as a transmitter and receiver bound to each other
+  const uint8_t fhssSchema[] = {2, 0, 3};
+  devices[DEV_MTX].dev->bind(0x2A, 0x15, fhssSchema, frameRate);
+  devices[DEV_STX].dev->bind(0x2A, 0x15, fhssSchema, frameRate);
+  devices[DEV_RECEIVER].dev->bind(0x2A, 0x15, fhssSchema, frameRate);
+  devices[DEV_RECEIVER].dev->onServoPulse(onServoPulse);
+
+  auto wallStart = std::chrono::steady_clock::now();
+  uint64_t endTime = (uint64_t) duration * 1000;
+  nextStepTime = WARMUP_US;
+
+  //--- Run, always advancing the device that is furthest behind
+  for(;;)
+  {
+    uint8_t slowest = 0;
+    for(uint8_t i = 1; i < NUM_DEVICES; i++)
+    {
+      if(devices[i].dev->time() < devices[slowest].dev->time())
+        slowest = i;
+    }
+    uint64_t now = devices[slowest].dev->time();
+    if(now >= endTime)
+      break;
+
+    if(!hasWarmedUp && now >= WARMUP_US)
+    {
+      hasWarmedUp = true;
+      for(uint8_t i = DEV_STX; i < NUM_DEVICES; i++)
+        radioAtWarmup[i] = *devices[i].dev->radioStats();
+      rcDroppedAtWarmup = devices[DEV_STX].dev->rcDataDropped();
+    }
+
+    if(slowest == DEV_MTX && now >= nextStepTime)
+    {
+      stepStick();
+      nextStepTime += (uint64_t) stepInterval * 1000;
+    }
+
+    uint64_t deadline = UINT64_MAX;
+    for(uint8_t i = 0; i < NUM_DEVICES; i++)
+    {
+      if(i != slowest)
+        deadline = std::min(deadline, devices[i].dev->time() + SYNC_QUANTUM_US);
+    }
+    if(slowest == DEV_MTX)
+      deadline = std::min(deadline, nextStepTime);
+    devices[slowest].deadline = std::max(deadline, now + 1);
+
+    for(uart_link_t &link : links)
+    {
+      if(link.to == slowest)
+        deliverUartBytes(&link);
+    }
+
+    currentDevice = slowest;
+    swapcontext(&schedulerContext, &devices[slowest].context);
+
+    for(uart_link_t &link : links)
+    {
+      if(link.from == slowest)
+        collectUartBytes(&link);
+    }
+  }
+
+  //a step too close to the end may not have reached the servo yet
+  if(stepDirection != 0 && endTime - stepTime < 200000)
+    numSteps--;
+  else if(stepDirection != 0)
+    numUnansweredSteps++;
+
+  //--- Summary
+  double wallSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  double virtSecs = endTime / 1e6;
+  double measureSecs = (endTime - WARMUP_US) / 1e6;
+  const host_radio_stats_t *stxRadio = devices[DEV_STX].dev->radioStats();
+  const host_radio_stats_t *rxRadio = devices[DEV_RECEIVER].dev->radioStats();
+  uint32_t stxSent = stxRadio->txPackets - radioAtWarmup[DEV_STX].txPackets;
+  uint32_t rxReceived = rxRadio->rxPackets - radioAtWarmup[DEV_RECEIVER].rxPackets;
+  uint32_t rxSent = rxRadio->txPackets - radioAtWarmup[DEV_RECEIVER].txPackets;
+  uint64_t stxAirTime = stxRadio->txAirTime - radioAtWarmup[DEV_STX].txAirTime;
+  uint32_t rcDropped = devices[DEV_STX].dev->rcDataDropped() - rcDroppedAtWarmup;
+
+  printf("---- System simulation summary ----\n");
+  printf("Virtual time       %.3f s, measured after the first %.1f s\n", virtSecs, WARMUP_US / 1e6);
+  printf("Host time          %.3f s (%.0fx real time)\n", wallSecs, wallSecs > 0 ? virtSecs / wallSecs : 0);
+  printf("Frame rate         %u Hz\n", frameRateHz);
+  printf("Main loops         mtx %u, stx %u, receiver %u\n", devices[DEV_MTX].dev->loops(),
+         devices[DEV_STX].dev->loops(), devices[DEV_RECEIVER].dev->loops());
+  printf("UART bytes         mtx to stx %u, stx to mtx %u, %u lost to full buffers\n",
+         links[0].bytes, links[1].bytes, links[0].dropped + links[1].dropped);
+  printf("RF packets         stx sent %u (%.1f/s), receiver got %u (%.1f/s), receiver sent %u\n",
+         stxSent, stxSent / measureSecs, rxReceived, rxReceived / measureSecs, rxSent);
+  printf("RF air time        stx %.1f %% (%.2f ms per packet), receiver %.1f %%\n",
+         stxRadio->txAirTime / (virtSecs * 1e4), stxSent > 0 ? stxAirTime / (stxSent * 1e3) : 0,
+         rxRadio->txAirTime / (virtSecs * 1e4));
+  printf("RF link telemetry  stx %u/s, receiver %u/s\n", reportedTxPacketRate, reportedRxPacketRate);
+  printf("RC data            mtx sent %u, %u dropped by stx\n", numRcData, rcDropped);
+
+  char extra[64];
+  snprintf(extra, sizeof(extra), ", %u of %u steps missed", numUnansweredSteps, numSteps);
+  printStats("Stick to servo", latencySamples, extra);
+  snprintf(extra, sizeof(extra), ", %.1f/s", numTelemetry / measureSecs);
+  printStats("Telemetry period", telemetrySamples, extra);
+
+  //a few frames are given up for telemetry
+  bool ok = !latencySamples.empty() && numUnansweredSteps == 0 && !telemetrySamples.empty()
+            && rxReceived / measureSecs >= 0.9 * frameRateHz && rcDropped == 0;
+  printf("Result             %s\n", ok ? "ok" : "FAILED");
+  fflush(stdout);
+  return ok ? 0 : 1;
+}